@@ -18,7 +18,11 @@ static const char* garlic_bin(void)
 #define SCHEMA_DECOMPILE  \
     "{\"type\":\"object\",\"properties\":{"  \
     "\"path\":{\"type\":\"string\",\"description\":\"Path to .class/.jar/.dex/.apk file\"},"  \
-    "\"output_dir\":{\"type\":\"string\",\"description\":\"Output directory for decompiled source\"}"  \
+    "\"output_dir\":{\"type\":\"string\",\"description\":\"Output directory for decompiled source\"},"  \
+    "\"include\":{\"type\":\"array\",\"items\":{\"type\":\"string\"},"  \
+    "\"description\":\"Only decompile classes matching these package/class prefixes or globs (com.foo, com.foo.*Activity, com.**.internal.*)\"},"  \
+    "\"exclude\":{\"type\":\"array\",\"items\":{\"type\":\"string\"},"  \
+    "\"description\":\"Skip classes matching these package/class prefixes or globs\"}"  \
     "},\"required\":[\"path\"]}"
 
 #define SCHEMA_DUMP_INFO  \
@@ -596,7 +600,42 @@ static char* process_error(const char *operation, int rc, const char *detail)
     return result;
 }
 
-static string tool_decompile(const char *path, const char *output_dir)
+#define MCP_DECOMPILE_MAX_ARGS 68
+
+/**
+ * "include"/"exclude" may be a string or an array of strings,
+ * every pattern becomes a -i/-x pair of the garlic command line
+ **/
+static int append_filter_args(const char **argv,
+                              int argc,
+                              const char *flag,
+                              cJSON *json)
+{
+    if (json == NULL)
+        return argc;
+    if (cJSON_IsString(json)) {
+        if (argc + 2 <= MCP_DECOMPILE_MAX_ARGS) {
+            argv[argc++] = flag;
+            argv[argc++] = json->valuestring;
+        }
+        return argc;
+    }
+    if (!cJSON_IsArray(json))
+        return argc;
+    cJSON *item = NULL;
+    cJSON_ArrayForEach(item, json) {
+        if (!cJSON_IsString(item) || argc + 2 > MCP_DECOMPILE_MAX_ARGS)
+            continue;
+        argv[argc++] = flag;
+        argv[argc++] = item->valuestring;
+    }
+    return argc;
+}
+
+static string tool_decompile(const char *path,
+                             const char *output_dir,
+                             cJSON *include,
+                             cJSON *exclude)
 {
     if (jd_mcp_detect_file_type(path) == JD_MCP_FILE_CLASS) {
         const char *argv[] = {garlic_bin(), path, NULL};
@@ -632,7 +671,13 @@ static string tool_decompile(const char *path, const char *output_dir)
         return strdup("Error: cannot create output directory");
     }
 
-    const char *argv[] = {garlic_bin(), path, "-o", save_dir, NULL};
+    const char *argv[MCP_DECOMPILE_MAX_ARGS + 1] = {
+        garlic_bin(), path, "-o", save_dir
+    };
+    int argc = 4;
+    argc = append_filter_args(argv, argc, "-i", include);
+    argc = append_filter_args(argv, argc, "-x", exclude);
+    argv[argc] = NULL;
     int rc = exec_process(argv, NULL, false, NULL);
     if (rc != 0) {
         if (!output_dir || output_dir[0] == '\0')
@@ -1023,7 +1068,10 @@ void mcp_handle_tools_call(jd_mcp_server *server, unsigned id,
         }
 
         if (STR_EQL(tool_name, "decompile")) {
-            output = tool_decompile(file_path, output_dir);
+            output = tool_decompile(file_path,
+                                    output_dir,
+                                    cJSON_GetObjectItem(args, "include"),
+                                    cJSON_GetObjectItem(args, "exclude"));
         }
         else if (STR_EQL(tool_name, "dump_info")) {
             output = tool_dump_info(file_path);
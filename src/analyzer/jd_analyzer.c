@@ -176,9 +176,8 @@ static void write_all_graph_node(jd_dumper_analyzer *analyzer)
 {
     struct hashmap_iter iter;
     hashmap_iter_init(analyzer->method_id_map, &iter);
-    struct hashmap_entry *_entry;
-    while ((_entry = hashmap_iter_next(&iter))) {
-        string_to_object *entry = (string_to_object *)_entry;
+    string_to_object *entry;
+    while ((entry = hashmap_iter_next(&iter))) {
         jd_graph_node *node = (jd_graph_node *)entry->value;
         fprintf(analyzer->method_node_stream, "%d,", node->id);
         csv_write_quoted(analyzer->method_node_stream, node->ident);
@@ -197,10 +196,9 @@ static void write_all_string(jd_dumper_analyzer *analyzer)
 {
     struct hashmap_iter iter;
     hashmap_iter_init(analyzer->string_map, &iter);
-    struct hashmap_entry *_entry;
+    string_to_object *entry;
     fprintf(analyzer->string_node_stream, "id,pc,str,is_class_desc,is_field_name,is_method_name,is_return_type,is_method_param_type,is_internal_class_desc,is_url,is_enc_dec,is_uuid,is_pem_key,is_so_name,is_ipv4\n");
-    while ((_entry = hashmap_iter_next(&iter))) {
-        string_to_object *entry = (string_to_object *)_entry;
+    while ((entry = hashmap_iter_next(&iter))) {
         jd_export_str *str = (jd_export_str *)entry->value;
         fprintf(analyzer->string_node_stream, "%" PRIu64 ",", str->id);
         fprintf(analyzer->string_node_stream, "%d,", 0);
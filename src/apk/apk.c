@@ -7,33 +7,39 @@
 #include "decompiler/expression_writter.h"
 #include "dex_smali.h"
 #include "apk_manifest.h"
+#include "decompiler/class_filter.h"
+#include "decompiler/schedule.h"
 
 static int apk_progress_len = 0;
+static pthread_mutex_t apk_progress_lock = PTHREAD_MUTEX_INITIALIZER;
 
 void apk_status(jd_apk *apk)
 {
-    pthread_mutex_lock(apk->threadpool->lock);
-    apk->done++;
+    __atomic_add_fetch(&apk->done, 1, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&apk_progress_lock);
     for (int i = 0; i < apk_progress_len; i++) putchar('\b');
-    apk_progress_len = printf("Progress : %d (%d)", apk->done, apk->added);
+    apk_progress_len = printf("Progress : %d (%d)",
+                              __atomic_load_n(&apk->done, __ATOMIC_RELAXED),
+                              __atomic_load_n(&apk->added, __ATOMIC_RELAXED));
     fflush(stdout);
-    pthread_mutex_unlock(apk->threadpool->lock);
+    pthread_mutex_unlock(&apk_progress_lock);
 }
 
 void apk_entry_thread_task(jd_meta_dex *meta)
 {
     thread_local_data *tls = get_thread_local_data();
-    tls->pool = mem_create_pool();
+    tls->pool = tls->arena;
 
     dex_analyse_in_apk_task(meta);
 
-    mem_pool_free(tls->pool);
+    mem_pool_clear(tls->pool);
 }
 
 void apk_decompile_thread_task(jd_dex_task *task)
 {
     thread_local_data *tls = get_thread_local_data();
-    tls->pool = mem_create_pool();
+    tls->pool = tls->arena;
 
     jd_dex *dex = task->dex;
     jd_apk *apk = task->apk;
@@ -46,7 +52,7 @@ void apk_decompile_thread_task(jd_dex_task *task)
         fclose(jf->source);
     }
 
-    mem_pool_free(tls->pool);
+    mem_pool_clear(tls->pool);
 
     apk_status(apk);
 }
@@ -54,7 +60,7 @@ void apk_decompile_thread_task(jd_dex_task *task)
 void apk_smali_thread_task(jd_dex_task *task)
 {
     thread_local_data *tls = get_thread_local_data();
-    tls->pool = mem_create_pool();
+    tls->pool = tls->arena;
 
     jd_dex *dex = task->dex;
     jd_apk *apk = task->apk;
@@ -67,12 +73,139 @@ void apk_smali_thread_task(jd_dex_task *task)
     if (stream != NULL)
         fclose(stream);
 
-    mem_pool_free(tls->pool);
+    mem_pool_clear(tls->pool);
 
     apk_status(apk);
 }
 
-static void apk_process_dex_from_zip(jd_apk *apk, struct zip_t *zip)
+#define ZIP_LOCAL_HEADER_SIGNATURE 0x04034b50
+#define ZIP_LOCAL_HEADER_SIZE      30
+
+/**
+ * bytes of the opened entry, a stored entry is returned in place from
+ * zip_buf (the mapped apk or a stored nested apk), a deflated one is
+ * inflated into pool
+ **/
+static char* apk_zip_entry_bytes(mem_pool *pool,
+                                 struct zip_t *zip,
+                                 char *zip_buf,
+                                 size_t zip_size,
+                                 size_t *size)
+{
+    size_t buf_size = zip_entry_size(zip);
+    size_t off = zip_entry_header_offset(zip);
+    *size = buf_size;
+
+    if (off + ZIP_LOCAL_HEADER_SIZE <= zip_size) {
+        u1 *h = (u1*)zip_buf + off;
+        u4 signature = h[0] | h[1] << 8 | h[2] << 16 | (u4)h[3] << 24;
+        u2 method = h[8] | h[9] << 8;
+        u2 name_len = h[26] | h[27] << 8;
+        u2 extra_len = h[28] | h[29] << 8;
+        size_t data_off = off + ZIP_LOCAL_HEADER_SIZE + name_len + extra_len;
+        // zipalign keeps stored entries 4-byte aligned, dex parser relies on it
+        if (signature == ZIP_LOCAL_HEADER_SIGNATURE &&
+            method == 0 &&
+            zip_entry_comp_size(zip) == buf_size &&
+            data_off + buf_size <= zip_size &&
+            ((uintptr_t)(zip_buf + data_off) & 3) == 0)
+            return zip_buf + data_off;
+    }
+
+    char *buf = x_alloc_raw_in(pool, buf_size);
+    zip_entry_noallocread(zip, (void *)buf, buf_size);
+    return buf;
+}
+
+static void apk_add_class_tasks(jd_apk *apk, jd_dex *dex)
+{
+    jd_meta_dex *meta = dex->meta;
+    jd_schedule schedule;
+    schedule_init(&schedule, apk->threadpool);
+    for (int j = 0; j < meta->header->class_defs_size; ++j) {
+        dex_class_def *cf = &meta->class_defs[j];
+        if (apk->type == JD_DEX_TASK_DECOMPILE) {
+            if (dex_class_is_inner_class(dex->meta, cf) ||
+                dex_class_is_anonymous_class(dex->meta, cf))
+                continue;
+            if (!dex_class_selected(meta, cf))
+                continue;
+        }
+        else if (!class_filter_match(dex_str_of_type_id(meta, cf->class_idx))) {
+            continue;
+        }
+
+        jd_dex_task *t = make_obj(jd_dex_task);
+        t->dex = dex;
+        t->cf = cf;
+        t->apk = apk;
+        t->type = apk->type;
+        if (t->type == JD_DEX_TASK_SMALI) {
+            threadpool_add(apk->threadpool,
+                           &apk_smali_thread_task,
+                           t,
+                           0);
+        }
+        else {
+            schedule_add(&schedule,
+                         &apk_decompile_thread_task,
+                         t,
+                         dex_str_of_type_id(meta, cf->class_idx),
+                         g_schedule_lpt ? dex_class_cost(meta, cf) : 0);
+        }
+        __atomic_add_fetch(&apk->added, 1, __ATOMIC_RELAXED);
+    }
+    schedule_submit(&schedule);
+}
+
+void apk_dex_thread_task(jd_apk_dex_task *task)
+{
+    thread_local_data *tls = get_thread_local_data();
+    jd_apk *apk = task->apk;
+
+    // the dex and its class tasks outlive this task, keep them off the arena
+    mem_pool *pool = mem_create_pool();
+    tls->pool = pool;
+
+    // dex tasks run side by side, adopt is not thread safe
+    pthread_mutex_lock(&apk->pool_lock);
+    mem_pool_adopt(apk->pool, pool);
+    pthread_mutex_unlock(&apk->pool_lock);
+
+    // miniz readers are not thread safe, every task reads with its own
+    struct zip_t *zip = zip_stream_open(task->zip_buf, task->zip_size, 0, 'r');
+    if (zip == NULL) {
+        tls->pool = tls->arena;
+        return;
+    }
+    zip_entry_openbyindex(zip, task->index);
+    size_t buf_size;
+    char *buf = apk_zip_entry_bytes(pool,
+                                    zip,
+                                    task->zip_buf,
+                                    task->zip_size,
+                                    &buf_size);
+    zip_entry_close(zip);
+    zip_stream_close(zip);
+
+    jd_meta_dex *meta = parse_dex_from_buffer(buf, buf_size);
+    mem_pool_adopt(pool, meta->pool);
+    jd_dex *dex = dex_init_without_thread(meta);
+    meta->source_dir = apk->save_dir;
+
+    apk_add_class_tasks(apk, dex);
+
+    tls->pool = tls->arena;
+}
+
+/**
+ * only index the zip here, every dex is inflated and parsed by a
+ * task of its own and queues its class tasks as soon as it is ready
+ **/
+static void apk_process_dex_from_zip(jd_apk *apk,
+                                     struct zip_t *zip,
+                                     char *zip_buf,
+                                     size_t zip_size)
 {
     int total = zip_entries_total(zip);
     for (int i = 0; i < total; ++i) {
@@ -85,68 +218,44 @@ static void apk_process_dex_from_zip(jd_apk *apk, struct zip_t *zip)
         }
 
         if (str_end_with(path_in_zip, ".apk")) {
-            size_t buf_size = zip_entry_size(zip);
-            char *buf = malloc(buf_size);
-            if (buf) {
-                zip_entry_noallocread(zip, (void *)buf, buf_size);
-                struct zip_t *nested = zip_stream_open(buf, buf_size, 0, 'r');
-                if (nested) {
-                    apk_process_dex_from_zip(apk, nested);
-                    zip_stream_close(nested);
-                }
-                free(buf);
-            }
-            zip_entry_close(zip);
-            continue;
-        }
-
-        if (!str_end_with(path_in_zip, ".dex")) {
+            size_t buf_size;
+            char *buf = apk_zip_entry_bytes(apk->pool,
+                                            zip,
+                                            zip_buf,
+                                            zip_size,
+                                            &buf_size);
             zip_entry_close(zip);
+            struct zip_t *nested = zip_stream_open(buf, buf_size, 0, 'r');
+            if (nested) {
+                apk_process_dex_from_zip(apk, nested, buf, buf_size);
+                zip_stream_close(nested);
+            }
             continue;
         }
 
-        size_t buf_size = zip_entry_size(zip);
-        char *buf = x_alloc_in(apk->pool, buf_size * sizeof(unsigned char));
-        zip_entry_noallocread(zip, (void *)buf, buf_size);
+        bool is_dex = str_end_with(path_in_zip, ".dex");
         zip_entry_close(zip);
+        if (!is_dex)
+            continue;
 
-        jd_meta_dex *meta = parse_dex_from_buffer(buf, buf_size);
-        jd_dex *dex = dex_init_without_thread(meta);
-        meta->source_dir = apk->save_dir;
-
-        for (int j = 0; j < meta->header->class_defs_size; ++j) {
-            dex_class_def *cf = &meta->class_defs[j];
-            if (apk->type == JD_DEX_TASK_DECOMPILE) {
-                if (dex_class_is_inner_class(dex->meta, cf) ||
-                    dex_class_is_anonymous_class(dex->meta, cf))
-                    continue;
-            }
-
-            jd_dex_task *t = make_obj(jd_dex_task);
-            t->dex = dex;
-            t->cf = cf;
-            t->apk = apk;
-            t->type = apk->type;
-            if (t->type == JD_DEX_TASK_SMALI) {
-                threadpool_add(apk->threadpool,
-                               &apk_smali_thread_task,
-                               t,
-                               0);
-            }
-            else {
-                threadpool_add(apk->threadpool,
-                               &apk_decompile_thread_task,
-                               t,
-                               0);
-            }
-            apk->added++;
-        }
+        jd_apk_dex_task *t = make_obj_in(jd_apk_dex_task, apk->pool);
+        t->apk = apk;
+        t->zip_buf = zip_buf;
+        t->zip_size = zip_size;
+        t->index = i;
+        threadpool_add(apk->threadpool, &apk_dex_thread_task, t, 0);
     }
 }
 
 static void apk_decompile_task_start(jd_apk *apk)
 {
-    struct zip_t *zip = zip_open(apk->path, 0, 'r');
+    size_t size;
+    char *buf = mem_pool_map_file(apk->pool, apk->path, &size);
+    struct zip_t *zip = zip_stream_open(buf, size, 0, 'r');
+    if (zip == NULL) {
+        fprintf(stderr, "[error]: %s is not a zip file\n", apk->path);
+        return;
+    }
     apk->zip = zip;
     apk->entries_size = zip_entries_total(zip);
 
@@ -162,8 +271,8 @@ static void apk_decompile_task_start(jd_apk *apk)
         zip_entry_close(zip);
     }
 
-    apk_process_dex_from_zip(apk, zip);
-    zip_close(zip);
+    apk_process_dex_from_zip(apk, zip, buf, size);
+    zip_stream_close(zip);
     apk->zip = NULL;
 }
 
@@ -172,6 +281,7 @@ static void apk_release(jd_apk *apk)
     if (apk->threadpool)
         threadpool_destroy(apk->threadpool, 1);
 
+    pthread_mutex_destroy(&apk->pool_lock);
     mem_pool_free(apk->pool);
     mem_free_pool();
 }
@@ -190,6 +300,7 @@ void apk_decompile_analyse(string path,
     apk->save_dir = save_dir;
     apk->thread_num = thread_num;
     apk->type = type;
+    pthread_mutex_init(&apk->pool_lock, NULL);
 
     if (thread_num > 1) {
         apk->threadpool = threadpool_create_in(apk->pool, thread_num, 0);
@@ -68,6 +68,10 @@
 } while (0)
 #endif
 
+#ifndef DEBUG_FIXPOINT
+#define DEBUG_FIXPOINT              DEBUG
+#endif
+
 #ifndef DEBUG_ERROR
 #define DEBUG_ERROR                 false
 #endif
@@ -18,7 +18,13 @@
 #define MIN(a,b) ((a) < (b) ? (a) : (b))
 #endif
 
-#define STR_EQL(a, b) (strcmp(a, b) == 0)
+// interned strings are equal by pointer, the rest falls back to strcmp
+static inline bool str_eql(const char *a, const char *b)
+{
+    return a == b || strcmp(a, b) == 0;
+}
+
+#define STR_EQL(a, b) (str_eql(a, b))
 
 static inline string str_create(string fmt, ...)
 {
@@ -28,7 +34,7 @@ static inline string str_create(string fmt, ...)
     va_list args2;
     va_copy(args2, args);
     int len = vsnprintf(NULL, 0, fmt, args2);
-    str = x_alloc(len+1);
+    str = x_alloc_raw(len+1);
     vsnprintf(str, len+1, fmt, args);
     va_end(args);
 
@@ -43,7 +49,7 @@ static inline string str_create_in(mem_pool *pool, string fmt, ...)
     va_list args2;
     va_copy(args2, args);
     int len = vsnprintf(NULL, 0, fmt, args2);
-    str = x_alloc_in(pool, len+1);
+    str = x_alloc_raw_in(pool, len+1);
     vsnprintf(str, len+1, fmt, args);
     str[len] = '\0';
     va_end(args);
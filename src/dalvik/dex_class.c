@@ -5,6 +5,8 @@
 #include "decompiler/method.h"
 #include "decompiler/descriptor.h"
 #include "decompiler/field.h"
+#include "decompiler/class_filter.h"
+#include "decompiler/schedule.h"
 
 bool dex_class_is_synthetic(jd_meta_dex *meta, dex_class_def *def) {
     if (def->class_data_off == 0) {
@@ -122,6 +124,67 @@ void dex_class_import(jsource_file *jf)
     }
 }
 
+static bool dex_class_nested_selected(jd_meta_dex *meta, dex_class_def *cf)
+{
+    list_object *lists[2] = {cf->inner_classes, cf->anonymous_classes};
+    for (int k = 0; k < 2; ++k) {
+        for (int i = 0; i < lists[k]->size; ++i) {
+            dex_class_def *nested = lget_obj(lists[k], i);
+            string cname = dex_str_of_type_id(meta, nested->class_idx);
+            if (class_filter_match_nested(cname) ||
+                dex_class_nested_selected(meta, nested))
+                return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * the top level class is decompiled when it or one of the nested
+ * classes decompiled inside its task is picked by the class filter
+ **/
+bool dex_class_selected(jd_meta_dex *meta, dex_class_def *cf)
+{
+    if (!class_filter_enabled())
+        return true;
+    string cname = dex_str_of_type_id(meta, cf->class_idx);
+    return class_filter_match(cname) || dex_class_nested_selected(meta, cf);
+}
+
+static u8 dex_methods_cost(encoded_method *methods, u4 size)
+{
+    u8 cost = 0;
+    for (u4 i = 0; i < size; ++i) {
+        cost += SCHEDULE_METHOD_COST;
+        if (methods[i].code != NULL)
+            cost += methods[i].code->insns_size;
+    }
+    return cost;
+}
+
+/**
+ * estimate of the class task for --lpt, code units of the class and
+ * of the nested classes decompiled inside its task
+ **/
+u8 dex_class_cost(jd_meta_dex *meta, dex_class_def *cf)
+{
+    u8 cost = SCHEDULE_CLASS_COST;
+    dex_class_data_item *data = cf->class_data;
+    if (data != NULL) {
+        cost += dex_methods_cost(data->direct_methods,
+                                 data->direct_methods_size);
+        cost += dex_methods_cost(data->virtual_methods,
+                                 data->virtual_methods_size);
+    }
+
+    list_object *lists[2] = {cf->inner_classes, cf->anonymous_classes};
+    for (int k = 0; k < 2; ++k) {
+        for (int i = 0; i < lists[k]->size; ++i)
+            cost += dex_class_cost(meta, lget_obj(lists[k], i));
+    }
+    return cost;
+}
+
 bool dex_class_is_inner_class(jd_meta_dex *meta, dex_class_def *cf) {
     string cname = dex_str_of_type_id(meta, cf->class_idx);
     string class_name = class_simple_name(cname);
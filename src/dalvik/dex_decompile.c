@@ -15,6 +15,11 @@
 #include "jvm/jvm_ins.h"
 #include "dex_pre_optimizer.h"
 #include "decompiler/control_flow.h"
+#include "decompiler/class_filter.h"
+#include "decompiler/profiler.h"
+#include "decompiler/method_budget.h"
+#include "decompiler/method_tasks.h"
+#include "decompiler/schedule.h"
 #include "jar/jar.h"
 #include "file_tools.h"
 #include "dex_annotation.h"
@@ -22,15 +27,19 @@
 #include "dex_smali.h"
 
 static int dex_progress_len = 0;
+static pthread_mutex_t dex_progress_lock = PTHREAD_MUTEX_INITIALIZER;
 
 void dex_status(jd_dex *dex)
 {
-    pthread_mutex_lock(dex->threadpool->lock);
-    dex->done++;
+    __atomic_add_fetch(&dex->done, 1, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&dex_progress_lock);
     for (int i = 0; i < dex_progress_len; i++) putchar('\b');
-    dex_progress_len = printf("Progress : %d (%d)", dex->done, dex->added);
+    dex_progress_len = printf("Progress : %d (%d)",
+                              __atomic_load_n(&dex->done, __ATOMIC_RELAXED),
+                              dex->added);
     fflush(stdout);
-    pthread_mutex_unlock(dex->threadpool->lock);
+    pthread_mutex_unlock(&dex_progress_lock);
 }
 
 void dex_main_thread_status(jd_dex *dex)
@@ -82,37 +91,81 @@ void dex_init_method_fn(jd_dex *dex)
     fn->is_synthetic = dex_method_is_synthetic;
     fn->is_varargs = dex_method_is_varargs;
     fn->is_abstract = dex_method_is_abstract;
+    fn->bytecode_fn = dex_method_bytecode;
     dex->method_fn = fn;
 }
 
-jd_method *dex_method(jsource_file *jf, encoded_method *em)
+static void dex_method_decompile(jsource_file *jf,
+                                 jd_method *m,
+                                 encoded_method *em)
 {
-    jd_method *m = make_obj(jd_method);
-
     dex_method_init(jf, m, em);
 
     if (method_is_empty(m))
-        return m;
+        return;
 
-    dex_method_exception_edge(m);
+    if (method_budget_exceeded(m))
+        return;
 
-    dex_simulator(m);
+    PROFILE_PASS(m, dex_method_exception_edge);
 
-    cfg_remove_exception_block(m);
+    if (method_budget_exceeded(m))
+        return;
+
+    PROFILE_PASS(m, dex_simulator);
+
+    PROFILE_PASS(m, cfg_remove_exception_block);
+
+    if (method_budget_exceeded(m))
+        return;
 
     pre_optimize_dex_method(m);
 
+    if (method_budget_exceeded(m))
+        return;
+
     optimize_dex_method(m);
+}
+
+jd_method *dex_method(jsource_file *jf, encoded_method *em)
+{
+    jd_method *m = make_obj(jd_method);
+    method_budget_begin(m);
+
+    PROFILE_METHOD(m, dex_method_decompile(jf, m, em));
 
     return m;
 }
 
+static jd_method* dex_method_task(jsource_file *jf, void *item)
+{
+    return dex_method(jf, item);
+}
+
+static void dex_methods_in_tasks(jsource_file *jf, dex_class_data_item *data)
+{
+    int size = data->direct_methods_size + data->virtual_methods_size;
+    void **items = make_obj_arr(void*, size);
+    for (int i = 0; i < data->direct_methods_size; ++i)
+        items[i] = &data->direct_methods[i];
+    for (int i = 0; i < data->virtual_methods_size; ++i)
+        items[data->direct_methods_size + i] = &data->virtual_methods[i];
+
+    method_tasks_run(jf, dex_method_task, items, size, jf->methods);
+}
+
 static void dex_methods(jsource_file *jf)
 {
     dex_class_def *cf = jf->jclass;
     dex_class_data_item *data = cf->class_data;
     jf->methods = linit_object();
 
+    if (method_tasks_enabled(data->direct_methods_size +
+                             data->virtual_methods_size)) {
+        dex_methods_in_tasks(jf, data);
+        return;
+    }
+
     for (int i = 0; i < data->direct_methods_size; ++i) {
         encoded_method *em = &data->direct_methods[i];
         jd_method *m = dex_method(jf, em);
@@ -173,9 +226,9 @@ static void dex_inner_class_list(jsource_file *jf)
     }
 }
 
-jsource_file* dex_class_inside(jd_dex *dex,
-                               dex_class_def *cf,
-                               jsource_file *parent)
+static jsource_file* dex_class_analyse(jd_dex *dex,
+                                       dex_class_def *cf,
+                                       jsource_file *parent)
 {
     dex_class_data_item *class_data = cf->class_data;
     jsource_file *jf = make_obj(jsource_file);
@@ -240,6 +293,17 @@ jsource_file* dex_class_inside(jd_dex *dex,
     return jf;
 }
 
+// names derived while analysing the class are interned per dex
+jsource_file* dex_class_inside(jd_dex *dex,
+                               dex_class_def *cf,
+                               jsource_file *parent)
+{
+    jd_intern *previous = intern_scope_enter(dex->meta->intern);
+    jsource_file *jf = dex_class_analyse(dex, cf, parent);
+    intern_scope_leave(previous);
+    return jf;
+}
+
 jsource_file* dex_inner_class(jd_dex *dex,
                               jsource_file *parent,
                               dex_class_def *cf)
@@ -355,7 +419,7 @@ jd_dex* dex_init_without_thread(jd_meta_dex *meta)
 void dex_decompile_thread_task(jd_dex_task *task)
 {
     thread_local_data *tls = get_thread_local_data();
-    tls->pool = mem_create_pool();
+    tls->pool = tls->arena;
 
     jd_dex *dex = task->dex;
     dex_class_def *cf = task->cf;
@@ -365,7 +429,7 @@ void dex_decompile_thread_task(jd_dex_task *task)
         writter_for_class(jf, NULL);
         fclose(jf->source);
     }
-    mem_pool_free(tls->pool);
+    mem_pool_clear(tls->pool);
 
     dex_status(dex);
 }
@@ -373,7 +437,7 @@ void dex_decompile_thread_task(jd_dex_task *task)
 void dex_smali_thread_task(jd_dex_task *task)
 {
     thread_local_data *tls = get_thread_local_data();
-    tls->pool = mem_create_pool();
+    tls->pool = tls->arena;
 
     jd_dex *dex = task->dex;
     dex_class_def *cf = task->cf;
@@ -385,7 +449,7 @@ void dex_smali_thread_task(jd_dex_task *task)
     if (stream != NULL)
         fclose(stream);
 
-    mem_pool_free(tls->pool);
+    mem_pool_clear(tls->pool);
 
     dex_status(dex);
 }
@@ -393,18 +457,27 @@ void dex_smali_thread_task(jd_dex_task *task)
 void dex_decompile_threadpool_start(jd_dex *dex)
 {
     jd_meta_dex *meta = dex->meta;
+    jd_schedule schedule;
+    schedule_init(&schedule, dex->threadpool);
     for (int i = 0; i < meta->header->class_defs_size; ++i) {
         dex_class_def *cf = &meta->class_defs[i];
         if (dex_class_is_inner_class(dex->meta, cf) ||
             dex_class_is_anonymous_class(dex->meta, cf))
             continue;
+        if (!dex_class_selected(meta, cf))
+            continue;
 
         jd_dex_task *t = make_obj(jd_dex_task);
         t->dex = dex;
         t->cf = cf;
-        threadpool_add(dex->threadpool, &dex_decompile_thread_task, t, 0);
+        schedule_add(&schedule,
+                     &dex_decompile_thread_task,
+                     t,
+                     dex_str_of_type_id(meta, cf->class_idx),
+                     g_schedule_lpt ? dex_class_cost(meta, cf) : 0);
         dex->added++;
     }
+    schedule_submit(&schedule);
 }
 
 void dex_decompile_main_thread_start(jd_dex *dex)
@@ -416,6 +489,8 @@ void dex_decompile_main_thread_start(jd_dex *dex)
         if (dex_class_is_inner_class(dex->meta, cf) ||
             dex_class_is_anonymous_class(dex->meta, cf))
             continue;
+        if (!dex_class_selected(meta, cf))
+            continue;
 
         jsource_file *jf = dex_class_inside(dex, cf, NULL);
         if (jf->parent == NULL) {
@@ -433,6 +508,8 @@ void dex_smali_threadpool_start(jd_dex *dex)
     jd_meta_dex *meta = dex->meta;
     for (int i = 0; i < meta->header->class_defs_size; ++i) {
         dex_class_def *cf = &meta->class_defs[i];
+        if (!class_filter_match(dex_str_of_type_id(meta, cf->class_idx)))
+            continue;
         jd_dex_task *t = make_obj(jd_dex_task);
         t->dex = dex;
         t->cf = cf;
@@ -446,8 +523,10 @@ void dex_smali_main_thread_start(jd_dex *dex)
 {
     jd_meta_dex *meta = dex->meta;
     for (int i = 0; i < meta->header->class_defs_size; ++i) {
-        mem_init_pool();
         dex_class_def *cf = &meta->class_defs[i];
+        if (!class_filter_match(dex_str_of_type_id(meta, cf->class_idx)))
+            continue;
+        mem_init_pool();
 
         FILE *stream = dex_class_smali_save_dir(dex, cf);
 
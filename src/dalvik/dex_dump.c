@@ -280,7 +280,7 @@ static void dexdump_write_method(jd_meta_dex *dex,
                 // const-string vAA, string@BBBB
                 u1 v_a = (*item >> 8);
                 u2 string_index = code->insns[i+1];
-                string str = dex->strings[string_index].data;
+                string str = dex_str_of_idx(dex, string_index);
                 printf("v%d, \"%s\" // string@%02x\n",
                         v_a, str, string_index);
                 break;
@@ -291,7 +291,7 @@ static void dexdump_write_method(jd_meta_dex *dex,
                 u2 index1 = code->insns[i+1];
                 u2 index2 = code->insns[i+2];
                 u4 string_index = ((u4)index2 << 16) | index1;
-                string str = dex->strings[string_index].data;
+                string str = dex_str_of_idx(dex, string_index);
                 printf("v%d, \"%s\" // string@%04x\n",
                         v_a, str, string_index);
                 break;
@@ -325,7 +325,7 @@ static void dexdump_write_method(jd_meta_dex *dex,
                 u1 v_b = (*item >> 8) & 0x0F;
                 u2 type_index = code->insns[i+1];
                 dex_type_id *type_id = &dex->type_ids[type_index];
-                string type_name = dex->strings[type_id->descriptor_idx].data;
+                string type_name = dex_str_of_idx(dex, type_id->descriptor_idx);
                 printf("v%d, v%d %s // type@%04x\n",
                        v_a, v_b, type_name, type_index);
                 break;
@@ -11,7 +11,7 @@
 static jd_dex_ins *try_item_end_ins(jd_method *m, dex_try_item *try)
 {
     u4 end_next_off = try->start_addr + try->insn_count;
-    int idx = hget_i2i(m->offset2id_map, end_next_off);
+    int idx = ins_idx_of_offset(m, end_next_off);
     if (idx == -1)
         return dex_ins_of_offset(m, try->start_addr);
 
@@ -21,7 +21,6 @@ jd_ins* make_goto_ins(jd_method *m, jd_support_type type, uint32_t offset)
     dex_setup_goto_offset(ins, offset);
 
     ladd_obj(m->instructions, ins);
-    hset_i2i(m->offset2id_map, ins->offset, ins->idx);
 
     return ins;
 }
@@ -37,9 +36,9 @@ jd_bblock* make_goto_basic_block(jd_method *m,
     block->type = JD_BB_NORMAL;
     block->live = JD_STATUS_BUSY;
 
-    block->in = linit_object_with_capacity(2);
-    block->out = linit_object_with_capacity(2);
-    block->dom_children = linit_object();
+    block->in = linit_obj_small();
+    block->out = linit_obj_small();
+    block->dom_children = linit_obj_small();
     block->frontier = linit_object_with_capacity(2);
     block->frontier->cmp_fn = (list_cmp_fn) basic_block_id_comparator;
     block->dominates = linit_object();
@@ -81,16 +80,15 @@ jd_bblock* dup_basic_block_and_ins(jd_method *m, jd_bblock *src_block)
         copy->prev = NULL;
         copy->next = NULL;
 
-        copy->comings = linit_object();
-        copy->jumps = linit_object();
-        copy->targets = linit_object();
+        copy->comings = linit_obj_small();
+        copy->jumps = linit_obj_small();
+        copy->targets = linit_obj_small();
         copy->code = src->code;
         copy->name = src->name;
 
         copy->offset = last->offset + copy->param_length;
         copy->idx = m->instructions->size;
         ladd_obj(m->instructions, copy);
-        hset_i2i(m->offset2id_map, copy->offset, copy->idx);
 
         if (i == src_nb->start_idx)
             start = copy;
@@ -112,9 +110,9 @@ jd_bblock* dup_basic_block_and_ins(jd_method *m, jd_bblock *src_block)
     new_b->live = JD_STATUS_BUSY;
     new_b->is_dup = true;
 
-    new_b->in = linit_object_with_capacity(2);
-    new_b->out = linit_object_with_capacity(2);
-    new_b->dom_children = linit_object();
+    new_b->in = linit_obj_small();
+    new_b->out = linit_obj_small();
+    new_b->dom_children = linit_obj_small();
     new_b->frontier = linit_object_with_capacity(2);
     new_b->frontier->cmp_fn = (list_cmp_fn) basic_block_id_comparator;
     new_b->dominates = linit_object();
@@ -940,157 +938,61 @@ static inline void dex_ins_use_def_51l(jd_dex_ins *ins)
     bitset_set(ins->defs, v_a);
 }
 
-void dex_ins_use_def_init(jd_dex_ins *ins) {
-    switch (ins->format) {
-        case kFmt10x:
-            dex_ins_use_def_10x(ins);
-            break;
-        case kFmt12x:
-            dex_ins_use_def_12x(ins);
-            break;
-        case kFmt11n:
-            dex_ins_use_def_11n(ins);
-            break;
-        case kFmt11x:
-            dex_ins_use_def_11x(ins);
-            break;
-        case kFmt10t:
-            dex_ins_use_def_10t(ins);
-            break;
-        case kFmt20t:
-            dex_ins_use_def_20t(ins);
-            break;
-        case kFmt22x:
-            dex_ins_use_def_22x(ins);
-            break;
-        case kFmt21t:
-            dex_ins_use_def_21t(ins);
-            break;
-        case kFmt21s:
-            dex_ins_use_def_21s(ins);
-            break;
-        case kFmt21h:
-            dex_ins_use_def_21h(ins);
-            break;
-        case kFmt21c:
-            dex_ins_use_def_21c(ins);
-            break;
-        case kFmt23x:
-            dex_ins_use_def_23x(ins);
-            break;
-        case kFmt22b:
-            dex_ins_use_def_22b(ins);
-            break;
-        case kFmt22t:
-            dex_ins_use_def_22t(ins);
-            break;
-        case kFmt22s:
-            dex_ins_use_def_22s(ins);
-            break;
-        case kFmt22c:
-            dex_ins_use_def_22c(ins);
-            break;
-        case kFmt30t:
-            dex_ins_use_def_30t(ins);
-            break;
-        case kFmt32x:
-            dex_ins_use_def_32x(ins);
-            break;
-        case kFmt31i:
-            dex_ins_use_def_31i(ins);
-            break;
-        case kFmt31t:
-            dex_ins_use_def_31t(ins);
-            break;
-        case kFmt31c:
-            dex_ins_use_def_31c(ins);
-            break;
-        case kFmt35c:
-            dex_ins_use_def_35c(ins);
-            break;
-        case kFmt3rc:
-            dex_ins_use_def_3rc(ins);
-            break;
-        case kFmt51l:
-            dex_ins_use_def_51l(ins);
-            break;
-        case kFmt45cc:
-            dex_ins_use_def_45cc(ins);
-            break;
-        case kFmt4rcc:
-            dex_ins_use_def_4rcc(ins);
-            break;
-        default:
-            break;
-    }
+typedef struct {
+    u8      (*parameter)(jd_dex_ins *ins, int number);
+    void    (*use_def)(jd_dex_ins *ins);
+} dex_format_fn;
+
+// operand decoders by format, formats without an entry have no operands
+static const dex_format_fn dex_format_fns[kFmtCount] = {
+    [kFmt10x]  = { dex_ins_parameter_10x,  dex_ins_use_def_10x },
+    [kFmt12x]  = { dex_ins_parameter_12x,  dex_ins_use_def_12x },
+    [kFmt11n]  = { dex_ins_parameter_11n,  dex_ins_use_def_11n },
+    [kFmt11x]  = { dex_ins_parameter_11x,  dex_ins_use_def_11x },
+    [kFmt10t]  = { dex_ins_parameter_10t,  dex_ins_use_def_10t },
+    [kFmt20t]  = { dex_ins_parameter_20t,  dex_ins_use_def_20t },
+    [kFmt22x]  = { dex_ins_parameter_22x,  dex_ins_use_def_22x },
+    [kFmt21t]  = { dex_ins_parameter_21t,  dex_ins_use_def_21t },
+    [kFmt21s]  = { dex_ins_parameter_21s,  dex_ins_use_def_21s },
+    [kFmt21h]  = { dex_ins_parameter_21h,  dex_ins_use_def_21h },
+    [kFmt21c]  = { dex_ins_parameter_21c,  dex_ins_use_def_21c },
+    [kFmt23x]  = { dex_ins_parameter_23x,  dex_ins_use_def_23x },
+    [kFmt22b]  = { dex_ins_parameter_22b,  dex_ins_use_def_22b },
+    [kFmt22t]  = { dex_ins_parameter_22t,  dex_ins_use_def_22t },
+    [kFmt22s]  = { dex_ins_parameter_22s,  dex_ins_use_def_22s },
+    [kFmt22c]  = { dex_ins_parameter_22c,  dex_ins_use_def_22c },
+    [kFmt30t]  = { dex_ins_parameter_30t,  dex_ins_use_def_30t },
+    [kFmt32x]  = { dex_ins_parameter_32x,  dex_ins_use_def_32x },
+    [kFmt31i]  = { dex_ins_parameter_31i,  dex_ins_use_def_31i },
+    [kFmt31t]  = { dex_ins_parameter_31t,  dex_ins_use_def_31t },
+    [kFmt31c]  = { dex_ins_parameter_31c,  dex_ins_use_def_31c },
+    [kFmt35c]  = { dex_ins_parameter_35c,  dex_ins_use_def_35c },
+    [kFmt3rc]  = { dex_ins_parameter_3rc,  dex_ins_use_def_3rc },
+    [kFmt51l]  = { dex_ins_parameter_51l,  dex_ins_use_def_51l },
+    [kFmt45cc] = { dex_ins_parameter_45cc, dex_ins_use_def_45cc },
+    [kFmt4rcc] = { dex_ins_parameter_4rcc, dex_ins_use_def_4rcc },
+};
+
+void dex_ins_use_def_init(jd_dex_ins *ins)
+{
+    void (*use_def)(jd_dex_ins*) = dex_format_fns[ins->format].use_def;
+    if (use_def != NULL)
+        use_def(ins);
 }
 
 u8 dex_ins_parameter(jd_dex_ins *ins, int number)
 {
-    switch (ins->format) {
-        case kFmt10x:
-            return dex_ins_parameter_10x(ins, number);
-        case kFmt12x:
-            return dex_ins_parameter_12x(ins, number);
-        case kFmt11n:
-            return dex_ins_parameter_11n(ins, number);
-        case kFmt11x:
-            return dex_ins_parameter_11x(ins, number);
-        case kFmt10t:
-            return dex_ins_parameter_10t(ins, number);
-        case kFmt20t:
-            return dex_ins_parameter_20t(ins, number);
-        case kFmt22x:
-            return dex_ins_parameter_22x(ins, number);
-        case kFmt21t:
-            return dex_ins_parameter_21t(ins, number);
-        case kFmt21s:
-            return dex_ins_parameter_21s(ins, number);
-        case kFmt21h:
-            return dex_ins_parameter_21h(ins, number);
-        case kFmt21c:
-            return dex_ins_parameter_21c(ins, number);
-        case kFmt23x:
-            return dex_ins_parameter_23x(ins, number);
-        case kFmt22b:
-            return dex_ins_parameter_22b(ins, number);
-        case kFmt22t:
-            return dex_ins_parameter_22t(ins, number);
-        case kFmt22s:
-            return dex_ins_parameter_22s(ins, number);
-        case kFmt22c:
-            return dex_ins_parameter_22c(ins, number);
-        case kFmt30t:
-            return dex_ins_parameter_30t(ins, number);
-        case kFmt32x:
-            return dex_ins_parameter_32x(ins, number);
-        case kFmt31i:
-            return dex_ins_parameter_31i(ins, number);
-        case kFmt31t:
-            return dex_ins_parameter_31t(ins, number);
-        case kFmt31c:
-            return dex_ins_parameter_31c(ins, number);
-        case kFmt35c:
-            return dex_ins_parameter_35c(ins, number);
-        case kFmt3rc:
-            return dex_ins_parameter_3rc(ins, number);
-        case kFmt51l:
-            return dex_ins_parameter_51l(ins, number);
-        case kFmt45cc:
-            return dex_ins_parameter_45cc(ins, number);
-        case kFmt4rcc:
-            return dex_ins_parameter_4rcc(ins, number);
-        default:
-            abort();
-    }
+    u8 (*parameter)(jd_dex_ins*, int) = dex_format_fns[ins->format].parameter;
+    if (parameter == NULL)
+        abort();
+    return parameter(ins, number);
 }
 
 int dex_switch_key(jd_dex_ins *ins, uint32_t target_offset)
 {
     jd_method *m = ins->method;
     s4 offset = (s4)(ins->param[2] << 16 | ins->param[1]);
-    hashmap *map = m->offset2id_map;
-    int payload_idx = hget_i2i(map, ins->offset + offset);
+    int payload_idx = ins_idx_of_offset(m, ins->offset + offset);
     jd_dex_ins *pins = lget_obj(m->instructions, payload_idx);
 
     if (dex_ins_is_packed_switch(ins)) {
@@ -1224,6 +1126,5 @@ jd_dex_ins* dup_dex_ins(jd_dex_ins *src)
     ins_mark_duplicate(ins);
 
     ladd_obj(m->instructions, ins);
-    hset_i2i(m->offset2id_map, ins->offset, ins->idx);
     return ins;
 }
\ No newline at end of file
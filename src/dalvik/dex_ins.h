@@ -4,6 +4,7 @@
 #include "dalvik/dex_structure.h"
 #include "dalvik/dex_ins_helper.h"
 #include "decompiler/instruction.h"
+#include "parser/dex/metadata.h"
 
 
 jd_ins* make_goto_ins(jd_method *m, jd_support_type type, uint32_t offset);
@@ -18,102 +19,45 @@ int dex_switch_key(jd_dex_ins *ins, uint32_t target_offset);
 
 bool dex_ins_type_changed(jd_dex_ins *ins);
 
+static inline bool dex_ins_has_flag(jd_dex_ins *ins, u2 flag)
+{
+    return ins->code < DEX_OPCODE_COUNT &&
+           (dex_opcodes[ins->code].flags & flag) != 0;
+}
+
 static inline bool dex_ins_is_unconditional_jump(jd_dex_ins *ins)
 {
-    switch (ins->code) {
-        case DEX_INS_GOTO:
-        case DEX_INS_GOTO_16:
-        case DEX_INS_GOTO_32:
-            return true;
-        default: return false;
-    }
+    return dex_ins_has_flag(ins, DEX_OPF_GOTO);
 }
 
 static inline bool dex_ins_is_conditional_jump(jd_dex_ins *ins)
 {
-    switch (ins->code) {
-        case DEX_INS_IF_EQ:
-        case DEX_INS_IF_NE:
-        case DEX_INS_IF_LT:
-        case DEX_INS_IF_GE:
-        case DEX_INS_IF_GT:
-        case DEX_INS_IF_LE:
-        case DEX_INS_IF_EQZ:
-        case DEX_INS_IF_NEZ:
-        case DEX_INS_IF_LTZ:
-        case DEX_INS_IF_GEZ:
-        case DEX_INS_IF_GTZ:
-        case DEX_INS_IF_LEZ:
-            return true;
-        default: return false;
-
-    }
+    return dex_ins_has_flag(ins, DEX_OPF_IF);
 }
 
 static inline bool dex_ins_is_if(jd_dex_ins *ins)
 {
-    switch (ins->code) {
-        case DEX_INS_IF_EQ:
-        case DEX_INS_IF_NE:
-        case DEX_INS_IF_LT:
-        case DEX_INS_IF_GE:
-        case DEX_INS_IF_GT:
-        case DEX_INS_IF_LE:
-        case DEX_INS_IF_EQZ:
-        case DEX_INS_IF_NEZ:
-        case DEX_INS_IF_LTZ:
-        case DEX_INS_IF_GEZ:
-        case DEX_INS_IF_GTZ:
-        case DEX_INS_IF_LEZ:
-            return true;
-        default: return false;
-    }
+    return dex_ins_has_flag(ins, DEX_OPF_IF);
 }
 
 static inline bool dex_ins_is_goto_jump(jd_dex_ins *ins)
 {
-    switch (ins->code) {
-        case DEX_INS_GOTO:
-        case DEX_INS_GOTO_16:
-        case DEX_INS_GOTO_32:
-            return true;
-        default: return false;
-    }
+    return dex_ins_has_flag(ins, DEX_OPF_GOTO);
 }
 
 static inline bool dex_ins_is_switch(jd_dex_ins *ins)
 {
-    switch (ins->code) {
-        case DEX_INS_SPARSE_SWITCH:
-        case DEX_INS_PACKED_SWITCH:
-            return true;
-        default: return false;
-    }
+    return dex_ins_has_flag(ins, DEX_OPF_SWITCH);
 }
 
 static inline bool dex_ins_is_return_op(jd_dex_ins *ins)
 {
-    switch (ins->code) {
-        case DEX_INS_RETURN:
-        case DEX_INS_RETURN_OBJECT:
-        case DEX_INS_RETURN_VOID:
-        case DEX_INS_RETURN_WIDE:
-            return true;
-        default: return false;
-    }
+    return dex_ins_has_flag(ins, DEX_OPF_RETURN);
 }
 
 static inline bool dex_ins_is_compare(jd_dex_ins *ins)
 {
-    switch (ins->code) {
-        case DEX_INS_CMPL_FLOAT:
-        case DEX_INS_CMP_LONG:
-        case DEX_INS_CMPG_DOUBLE:
-        case DEX_INS_CMPL_DOUBLE:
-        case DEX_INS_CMPG_FLOAT:
-            return true;
-        default: return false;
-    }
+    return dex_ins_has_flag(ins, DEX_OPF_COMPARE);
 }
 
 static inline u4 dex_ins_if_jump_offset(jd_dex_ins *ins)
@@ -195,8 +139,7 @@ static inline bool dex_ins_is_goto_back(jd_dex_ins *ins)
 
 static inline bool dex_ins_is_copy_basic_block(jd_dex_ins *ins)
 {
-    return ins->code == DEX_INS_COPY_BASIC_BLOCK ||
-           ins->code == DEX_INS_COPY_BASIC_BLOCK_GOTO;
+    return dex_ins_has_flag(ins, DEX_OPF_COPY_BLOCK);
 }
 
 static inline bool dex_ins_is_handler_start(jd_dex_ins *ins)
@@ -212,11 +155,7 @@ static inline bool dex_ins_is_handler_start(jd_dex_ins *ins)
 
 static inline bool dex_ins_is_block_end(jd_dex_ins *ins)
 {
-    return dex_ins_is_conditional_jump(ins) ||
-           dex_ins_is_switch(ins) ||
-           dex_ins_is_goto_jump(ins) ||
-           dex_ins_is_return_op(ins) ||
-           dex_ins_is_copy_basic_block(ins);
+    return dex_ins_has_flag(ins, DEX_OPF_BLOCK_END);
 }
 
 static inline bool dex_ins_is_block_start(jd_dex_ins *ins)
@@ -229,10 +168,7 @@ static inline bool dex_ins_is_block_start(jd_dex_ins *ins)
 
 static inline bool dex_ins_is_branch(jd_dex_ins *ins)
 {
-    return dex_ins_is_if(ins) ||
-        dex_ins_is_goto_jump(ins) ||
-        dex_ins_is_switch(ins);
-
+    return dex_ins_has_flag(ins, DEX_OPF_BRANCH);
 }
 
 static inline bool dex_ins_is_store(jd_dex_ins *ins)
@@ -254,10 +190,7 @@ static inline bool dex_ins_is_load(jd_dex_ins *ins)
 
 static inline bool dex_ins_is_invokedymamic(jd_dex_ins *ins)
 {
-    return ins->code == DEX_INS_INVOKE_POLYMORPHIC ||
-        ins->code == DEX_INS_INVOKE_CUSTOM ||
-        ins->code == DEX_INS_INVOKE_POLYMORPHIC_RANGE ||
-        ins->code == DEX_INS_INVOKE_CUSTOM_RANGE;
+    return dex_ins_has_flag(ins, DEX_OPF_INVOKE_DYNAMIC);
 }
 
 static inline bool dex_ins_is_invokevirtual(jd_dex_ins *ins)
@@ -290,26 +223,12 @@ static inline bool dex_ins_is_invokespecial(jd_dex_ins *ins)
 
 static inline bool dex_ins_is_move_to(jd_dex_ins *ins)
 {
-    switch (ins->code) {
-        case DEX_INS_MOVE:
-        case DEX_INS_MOVE_FROM16:
-        case DEX_INS_MOVE_16:
-        case DEX_INS_MOVE_WIDE:
-        case DEX_INS_MOVE_WIDE_FROM16:
-        case DEX_INS_MOVE_WIDE_16:
-        case DEX_INS_MOVE_OBJECT:
-        case DEX_INS_MOVE_OBJECT_FROM16:
-        case DEX_INS_MOVE_OBJECT_16:
-            return true;
-        default: return false;
-    }
+    return dex_ins_has_flag(ins, DEX_OPF_MOVE);
 }
 
 static inline bool dex_is_is_move_after_invoke(jd_dex_ins *ins)
 {
-    return dex_ins_is_move_result(ins) ||
-        dex_ins_is_move_result_object(ins) ||
-        dex_ins_is_move_result_wide(ins);
+    return dex_ins_has_flag(ins, DEX_OPF_MOVE_RESULT);
 }
 
 static inline bool dex_ins_is_jump_destination(jd_dex_ins *ins)
@@ -319,8 +238,7 @@ static inline bool dex_ins_is_jump_destination(jd_dex_ins *ins)
 
 static inline jd_dex_ins* dex_ins_of_offset(jd_method *m, u4 offset)
 {
-    int idx = hget_i2i(m->offset2id_map, offset);
-    return lget_obj(m->instructions, idx);
+    return ins_ptr_of_offset(m, offset);
 }
 
 static inline jd_dex_ins* get_dex_ins(jd_method *m, int idx)
@@ -707,7 +707,7 @@ static inline void build_dex_ins_invoke_act(jd_dex_ins *ins)
 
         dex_type_item *type_item = &proto_id->type_list->list[type_increase];
         dex_type_id *tid = &meta->type_ids[type_item->type_idx];
-        string type = meta->strings[tid->descriptor_idx].data;
+        string type = dex_str_of_idx(meta, tid->descriptor_idx);
         if (STR_EQL(type, "Z") && !stack_val_is_boolean(val)) {
             val->data->cname = (string)g_str_boolean;
             val->stack_var->cname = (string)g_str_boolean;
@@ -770,7 +770,7 @@ static void build_dex_ins_invoke_range_act(jd_dex_ins *ins)
 
         dex_type_item *type_item = &proto_id->type_list->list[type_increase];
         dex_type_id *tid = &meta->type_ids[type_item->type_idx];
-        string type = meta->strings[tid->descriptor_idx].data;
+        string type = dex_str_of_idx(meta, tid->descriptor_idx);
         if (STR_EQL(type, "Z") && !stack_val_is_boolean(val)) {
             val->data->cname = (string)g_str_boolean;
             val->stack_var->cname = (string)g_str_boolean;
@@ -5,6 +5,7 @@
 #include "decompiler/klass.h"
 #include "decompiler/expression.h"
 #include "decompiler/descriptor.h"
+#include "decompiler/method.h"
 
 jd_exp_lambda* dex_lambda(jsource_file *jf, jd_exp_invoke *invoke)
 {
@@ -20,7 +21,7 @@ jd_exp_lambda* dex_lambda(jsource_file *jf, jd_exp_invoke *invoke)
             break;
         }
     }
-    if (not_synthetic == NULL)
+    if (not_synthetic == NULL || method_is_truncated(not_synthetic))
         return NULL;
 
     jd_exp *last_invoke = NULL;
@@ -67,7 +68,9 @@ jd_exp_lambda* dex_lambda(jsource_file *jf, jd_exp_invoke *invoke)
 
     jd_exp_lambda *exp_lambda = make_obj(jd_exp_lambda);
     jd_ins_fn *fn = last_invoke->ins->fn;
-    if (em == NULL) {
+    jd_method *target = em != NULL ? dex_method(jf, em) : NULL;
+    // a body cut off by the budget is referenced by name
+    if (target == NULL || method_is_truncated(target)) {
         // is object::method_name
         exp_lambda->method = NULL;
         exp_lambda->method_name = last_exp_invoke->method_name;
@@ -75,7 +78,6 @@ jd_exp_lambda* dex_lambda(jsource_file *jf, jd_exp_invoke *invoke)
         exp_lambda->is_static = fn->is_invoke_static(last_invoke->ins);
     }
     else {
-        jd_method *target = dex_method(jf, em);
         exp_lambda->method = target;
         exp_lambda->method_name = target->name;
         exp_lambda->class_name = last_exp_invoke->class_name;
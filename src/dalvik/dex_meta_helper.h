@@ -6,7 +6,7 @@
 
 static inline string dex_str_of_idx(jd_meta_dex *meta, u4 idx)
 {
-    return meta->strings[idx].data;
+    return dex_string_data(meta, idx);
 }
 
 static inline string dex_str_of_type_id(jd_meta_dex *meta, u2 idx)
@@ -42,7 +42,7 @@ static inline string dex_method_class_descriptor(jd_meta_dex *meta,
     // m's class desc
     dex_method_id *method_id = &meta->method_ids[em->method_id];
     dex_type_id *type_id = &meta->type_ids[method_id->class_idx];
-    return meta->strings[type_id->descriptor_idx].data;
+    return dex_str_of_idx(meta, type_id->descriptor_idx);
 }
 
 static inline string dex_field_desc(jd_meta_dex *meta, encoded_field *efield)
@@ -50,13 +50,13 @@ static inline string dex_field_desc(jd_meta_dex *meta, encoded_field *efield)
     // field's class desc
     dex_field_id *field_id = &meta->field_ids[efield->field_id];
     dex_type_id *type_id = &meta->type_ids[field_id->class_idx];
-    return meta->strings[type_id->descriptor_idx].data;
+    return dex_str_of_idx(meta, type_id->descriptor_idx);
 }
 
 static inline string dex_field_name(jd_meta_dex *meta, encoded_field *efield)
 {
     // field's name
     dex_field_id *field_id = &meta->field_ids[efield->field_id];
-    return meta->strings[field_id->name_idx].data;
+    return dex_str_of_idx(meta, field_id->name_idx);
 }
 #endif //GARLIC_DEX_META_HELPER_H
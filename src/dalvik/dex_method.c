@@ -4,6 +4,7 @@
 #include "dex_exception.h"
 #include "parser/dex/metadata.h"
 #include "dex_annotation.h"
+#include "dex_smali.h"
 
 void dex_method_access_flag_with_flags(u4 flags, str_list *list)
 {
@@ -22,6 +23,11 @@ void dex_method_access_flags(jd_method *m, str_list *list)
     dex_method_access_flag_with_flags(m->access_flags, list);
 }
 
+void dex_method_bytecode(jd_method *m, FILE *stream)
+{
+    dex_method_to_smali(dex_method_meta(m), m->meta_method, stream);
+}
+
 jd_val* dex_method_parameter_val(jd_method *m, int index)
 {
     if (m->enter == NULL)
@@ -69,8 +75,7 @@ static void init_dex_packed_switch_jump(jd_dex_ins *ins)
 {
     jd_method *m = ins->method;
     s4 packed_offset = (s4)ins->param[2] << 16 | ins->param[1];
-    hashmap *map = m->offset2id_map;
-    int payload_idx = hget_i2i(map, ins->offset + packed_offset);
+    int payload_idx = ins_idx_of_offset(m, ins->offset + packed_offset);
     jd_dex_ins *packed_ins = lget_obj(m->instructions, payload_idx);
 
     int size = packed_ins->param[1];
@@ -93,7 +98,7 @@ static void init_dex_sparse_switch_jump(jd_dex_ins *ins)
 {
     jd_method *m = ins->method;
     s4 offset = ins->param[2] << 16 | ins->param[1];
-    int payload_idx = hget_i2i(m->offset2id_map, ins->offset + offset);
+    int payload_idx = ins_idx_of_offset(m, ins->offset + offset);
     jd_dex_ins *packed_ins = lget_obj(m->instructions, payload_idx);
     int size = packed_ins->param[1];
 
@@ -101,7 +106,7 @@ static void init_dex_sparse_switch_jump(jd_dex_ins *ins)
     for (int i = 0; i < size; ++i) {
         int key = params[3+i*2] << 16 | params[2+i*2];
         int val = params[3+size*2+i*2] << 16 | params[2+size*2+i*2];
-        int target_id = hget_i2i(m->offset2id_map, ins->offset + val);
+        int target_id = ins_idx_of_offset(m, ins->offset + val);
         jd_dex_ins *target_ins = get_dex_ins(m, target_id);
         ladd_obj(ins->targets, target_ins);
         ladd_obj(ins->jumps, target_ins);
@@ -142,35 +147,64 @@ static void init_dex_instruction_graph(jd_method *m)
     }
 }
 
+// in code units, the payload pseudo instructions carry their own size
+static u2 dex_ins_param_length(u2 *insns, uint32_t i)
+{
+    u2 item = insns[i];
+    u1 opcode = item & 0xFF;
+    if (opcode != 0x00)
+        return dex_opcode_len(opcode);
+    if (item == 0x0100) {
+        u2 size = insns[i+1];
+        return size * 2 + 4;
+    }
+    else if (item == 0x0200) {
+        u2 size = insns[i+1];
+        return size * 4 + 2;
+    }
+    else if (item == 0x0300) {
+        u2 element_size = insns[i+1];
+        u2 size = insns[i+2];
+        return (size * element_size + 1) / 2 + 4;
+    }
+    return 1;
+}
+
+/**
+ * the instructions are counted first, then built in one contiguous
+ * array, prev/next neighbours are adjacent in memory
+ **/
 static void dex_code_item_instruction(jd_method *m, dex_code_item *code)
 {
-    m->instructions = linit_object();
-    m->offset2id_map = hashmap_init((hcmp_fn) i2i_cmp, 0);
-    jd_dex_ins *prev = NULL;
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < code->insns_size; ++size)
+        i += dex_ins_param_length(code->insns, i);
+
+    jd_dex_ins *arr = make_obj_arr(jd_dex_ins, size);
+    m->instructions = linit_object_with_capacity(size);
+    jd_ins_fn *ins_fn = ((jd_dex*)(m->meta))->ins_fn;
     uint32_t offset = 0;
-    for (int i = 0; i < code->insns_size; ++i) {
-        u2 item = code->insns[i];
-        u1 opcode = item & 0xFF;
+    for (uint32_t k = 0; k < size; ++k) {
+        u1 opcode = code->insns[offset] & 0xFF;
 
-        jd_dex_ins *ins = make_obj(jd_dex_ins);
+        jd_dex_ins *ins = &arr[k];
         ins->code = opcode;
         ins->name = dex_opcode_name(opcode);
         ins->format = dex_opcode_fmt(opcode);
-        ins->idx = m->instructions->size;
+        ins->idx = (int)k;
         ins->offset = offset;
+        ins->param_length = dex_ins_param_length(code->insns, offset);
         ins->type = m->type;
-        ins->targets = linit_object_with_capacity(1);
-        ins->jumps = linit_object_with_capacity(2);
-        ins->comings = linit_object_with_capacity(1);
-        ins->extra = NULL;
+        ins->targets = linit_obj_small();
+        ins->jumps = linit_obj_small();
+        ins->comings = linit_obj_small();
 
         ins->method = m;
-        ins->param = &code->insns[i];
+        ins->param = &code->insns[offset];
         ins->uses = bitset_create_with_capacity(m->max_locals);
         ins->defs = bitset_create_with_capacity(m->max_locals);
-        ins->fn = ((jd_dex*)(m->meta))->ins_fn;
+        ins->fn = ins_fn;
         ladd_obj(m->instructions, ins);
-        hset_i2i(m->offset2id_map, offset, ins->idx);
         dex_ins_use_def_init(ins);
 
         if (dex_ins_is_goto_jump(ins)) {
@@ -186,37 +220,11 @@ static void dex_code_item_instruction(jd_method *m, dex_code_item *code)
             ins->param = new_param;
         }
 
-        if (opcode == 0x00) {
-            if (item == 0x0100) {
-                u2 size = code->insns[i+1];
-                ins->param_length = size * 2 + 4;
-            }
-            else if (item == 0x0200) {
-                u2 size = code->insns[i+1];
-                ins->param_length = size * 4 + 2;
-            }
-            else if (item == 0x0300) {
-                u2 element_size = code->insns[i+1];
-                u2 size = code->insns[i+2];
-                ins->param_length = (size * element_size + 1) / 2 + 4;
-            }
-            else {
-                ins->param_length = 1;
-            }
-        }
-        else {
-            ins->param_length = dex_opcode_len(opcode);
+        if (k > 0) {
+            ins->prev = &arr[k - 1];
+            arr[k - 1].next = ins;
         }
-        i += (ins->param_length - 1);
         offset += ins->param_length;
-
-        if (prev == NULL)
-            ins->prev = NULL;
-        else {
-            ins->prev = prev;
-            prev->next = ins;
-        }
-        prev = ins;
     }
 }
 
@@ -17,11 +17,13 @@ void dex_method_access_flag_with_flags(u4 flags, str_list *list);
 
 void dex_method_access_flags(jd_method *m, str_list *list);
 
+void dex_method_bytecode(jd_method *m, FILE *stream);
+
 static inline bool dex_encoded_method_is_lambda(jd_meta_dex *meta,
                                                 encoded_method *em)
 {
     dex_method_id method_id = meta->method_ids[em->method_id];
-    string name = meta->strings[method_id.name_idx].data;
+    string name = dex_string_data(meta, method_id.name_idx);
     return str_contains(name, "lambda$") ||
             (em->access_flags & ACC_DEX_SYNTHETIC) != 0;
 }
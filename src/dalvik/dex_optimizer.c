@@ -23,63 +23,79 @@
 #include "decompiler/expression_node_param.h"
 #include "decompiler/expression_return.h"
 #include "decompiler/expression_exception.h"
-
+#include "decompiler/profiler.h"
+#include "decompiler/pass_manager.h"
+#include "decompiler/method_budget.h"
+
+
+static const jd_fixpoint_pass dex_fixpoint_passes[] = {
+    FIXPOINT_PASS(identify_logical_operations,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP | JD_CHANGE_CONDITION,
+                  JD_CHANGE_CONTROL | JD_CHANGE_CONDITION),
+    FIXPOINT_PASS(identify_reverse_logical_operation,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP | JD_CHANGE_CONDITION,
+                  JD_CHANGE_CONTROL | JD_CHANGE_CONDITION),
+//    FIXPOINT_PASS(identify_ternary_operator),
+//    FIXPOINT_PASS(identify_ternary_operator_in_condition),
+    FIXPOINT_PASS(identify_initialize,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT),
+    FIXPOINT_PASS(identify_array_initialize,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP | JD_CHANGE_VALUE,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT),
+    FIXPOINT_PASS(copy_propagation_of_expression,
+                  JD_CHANGE_VALUE | JD_CHANGE_COUNT,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT |
+                  JD_CHANGE_CONDITION),
+};
 
 void optimize_dex_method(jd_method *m)
 {
     if (method_is_empty(m))
         return;
 
-    dex_instruction_to_expression(m);
-
-    negative_if_expression(m);
-
-    nop_empty_expression(m);
-
-    identify_cmp_after_if(m);
-
-    create_node_tree(m);
+    PROFILE_PASS(m, dex_instruction_to_expression);
 
-    bool changed = false;
+    PROFILE_PASS(m, negative_if_expression);
 
-    do {
-        changed = identify_logical_operations(m);
+    PROFILE_PASS(m, nop_empty_expression);
 
-        changed |= identify_reverse_logical_operation(m);
+    PROFILE_PASS(m, identify_cmp_after_if);
 
-//        changed |= identify_ternary_operator(m);
+    PROFILE_PASS(m, create_node_tree);
 
-//        changed |= identify_ternary_operator_in_condition(m);
-
-        changed |= identify_initialize(m);
-
-        changed |= identify_array_initialize(m);
+    if (method_budget_exceeded(m))
+        return;
 
-        changed |= copy_propagation_of_expression(m);
+    run_fixpoint_passes(m,
+                        dex_fixpoint_passes,
+                        sizeof(dex_fixpoint_passes) /
+                        sizeof(dex_fixpoint_passes[0]));
 
-    } while (changed);
+    if (method_budget_exceeded(m))
+        return;
 
-    identify_assignment(m);
+    PROFILE_PASS(m, identify_assignment);
 
-    identify_loop(m);
+    PROFILE_PASS(m, identify_loop);
 
-    identify_branches(m);
+    PROFILE_PASS(m, identify_branches);
 
-    identify_if_break_or_if_continue(m);
+    PROFILE_PASS(m, identify_if_break_or_if_continue);
 
-    identify_synchronized(m);
+    PROFILE_PASS(m, identify_synchronized);
 
-    optimize_goto_expression(m);
+    PROFILE_PASS(m, optimize_goto_expression);
 
-    analyse_local_variables(m);
+    PROFILE_PASS(m, analyse_local_variables);
 
-    identify_loop_type(m);
+    PROFILE_PASS(m, identify_loop_type);
 
 //    remove_empty_if_else_of_method(m);
 
-    nop_node_last_return(m);
+    PROFILE_PASS(m, nop_node_last_return);
 
-    setup_expression_node_param(m);
+    PROFILE_PASS(m, setup_expression_node_param);
 
-    optimize_exception_block(m);
+    PROFILE_PASS(m, optimize_exception_block);
 }
@@ -3,6 +3,7 @@
 
 #include "decompiler/dominator_tree.h"
 #include "decompiler/control_flow.h"
+#include "decompiler/profiler.h"
 #include "jvm/jvm_ins.h"
 
 static inline bool is_goto_edge(jd_edge *edge)
@@ -218,9 +219,9 @@ static void optimize_share_suffix_v2(jd_method *m)
 
 void pre_optimize_dex_method(jd_method *m)
 {
-    cfg_create(m);
+    PROFILE_PASS(m, cfg_create);
 
-    optimize_goto_to_return(m);
+    PROFILE_PASS(m, optimize_goto_to_return);
 
-    optimize_share_suffix_v2(m);
+    PROFILE_PASS(m, optimize_share_suffix_v2);
 }
@@ -33,7 +33,7 @@ static jd_stack* dex_exception_stack(jd_method *m,
         jd_dex *dex = m->meta;
         jd_meta_dex *meta = dex->meta;
         dex_type_id *type_id = &meta->type_ids[catch_type_index];
-        class_desc = meta->strings[type_id->descriptor_idx].data;
+        class_desc = dex_string_data(meta, type_id->descriptor_idx);
     }
 
     jd_stack *clone = stack_clone(src);
@@ -227,7 +227,7 @@ static void smali_write_method(jd_meta_dex *dex,
                 // const-string vAA, string@BBBB
                 u1 v_a = (*item >> 8);
                 u2 string_index = code->insns[i+1];
-                string str = dex->strings[string_index].data;
+                string str = dex_str_of_idx(dex, string_index);
                 fprintf(_smali_stream(stream), "v%d, \"%s\"\n", v_a, str);
                 break;
             }
@@ -237,7 +237,7 @@ static void smali_write_method(jd_meta_dex *dex,
                 u2 index1 = code->insns[i+1];
                 u2 index2 = code->insns[i+2];
                 u4 string_index = ((u4)index2 << 16) | index1;
-                string str = dex->strings[string_index].data;
+                string str = dex_str_of_idx(dex, string_index);
                 fprintf(_smali_stream(stream), "v%d, \"%s\"\n", v_a, str);
                 break;
             }
@@ -270,7 +270,7 @@ static void smali_write_method(jd_meta_dex *dex,
                 u1 v_b = (*item >> 8) & 0x0F;
                 u2 type_index = code->insns[i+1];
                 dex_type_id *type_id = &dex->type_ids[type_index];
-                string type_name = dex->strings[type_id->descriptor_idx].data;
+                string type_name = dex_str_of_idx(dex, type_id->descriptor_idx);
                 fprintf(_smali_stream(stream), "v%d, v%d, %s\n",
                        v_a, v_b, type_name);
                 break;
@@ -1122,6 +1122,16 @@ void dex_class_def_to_smali(jd_meta_dex *dex, dex_class_def *cf, FILE *stream)
     }
 }
 
+void dex_method_to_smali(jd_meta_dex *dex, encoded_method *m, FILE *stream)
+{
+    if (m->code == NULL)
+        return;
+    bool direct = access_flags_contains(m->access_flags, ACC_DEX_STATIC) ||
+                  access_flags_contains(m->access_flags, ACC_DEX_PRIVATE) ||
+                  access_flags_contains(m->access_flags, ACC_DEX_CONSTRUCTOR);
+    smali_write_method(dex, m, m->code, direct ? 0 : 1, stream);
+}
+
 void dex_to_smali(string path)
 {
     mem_init_pool();
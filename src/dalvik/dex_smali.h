@@ -6,4 +6,6 @@ void dex_to_smali(string path);
 
 void dex_class_def_to_smali(jd_meta_dex *dex, dex_class_def *cf, FILE *stream);
 
+void dex_method_to_smali(jd_meta_dex *dex, encoded_method *m, FILE *stream);
+
 #endif //GARLIC_DEX_SMALI_H
@@ -90,6 +90,8 @@ typedef struct jd_apk {
     struct zip_t        *zip;
     size_t              entries_size;
     mem_pool            *pool;
+    // guards adopting the pools of the dex tasks into pool
+    pthread_mutex_t     pool_lock;
     threadpool_t        *threadpool;
     jd_dex_task_type    type;
     int                 added;
@@ -103,4 +105,15 @@ typedef struct {
     jd_dex_task_type type;
 } jd_dex_task;
 
+/**
+ * inflate and parse one dex of an apk on a worker,
+ * zip_buf is the (nested) apk holding the dex entry
+ **/
+typedef struct {
+    jd_apk *apk;
+    char *zip_buf;
+    size_t zip_size;
+    int index;
+} jd_apk_dex_task;
+
 #endif //GARLIC_DEX_STRUCTURE_H
@@ -0,0 +1,135 @@
+#include <stdlib.h>
+#include <string.h>
+#include "decompiler/class_filter.h"
+
+typedef struct {
+    char    **patterns;
+    int     size;
+    int     capacity;
+} class_filter_list;
+
+static class_filter_list filter_includes;
+static class_filter_list filter_excludes;
+
+static void class_filter_add(class_filter_list *list, const char *pattern)
+{
+    if (pattern == NULL || pattern[0] == '\0')
+        return;
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity == 0 ? 8 : list->capacity * 2;
+        list->patterns = realloc(list->patterns,
+                                 sizeof(char*) * list->capacity);
+    }
+    // patterns are kept in internal form, com.foo.Bar -> com/foo/Bar
+    char *p = strdup(pattern);
+    for (char *c = p; *c; c++) {
+        if (*c == '.')
+            *c = '/';
+    }
+    list->patterns[list->size++] = p;
+}
+
+void class_filter_include(const char *pattern)
+{
+    class_filter_add(&filter_includes, pattern);
+}
+
+void class_filter_exclude(const char *pattern)
+{
+    class_filter_add(&filter_excludes, pattern);
+}
+
+bool class_filter_enabled()
+{
+    return filter_includes.size > 0 || filter_excludes.size > 0;
+}
+
+static bool class_filter_glob(const char *p, const char *s)
+{
+    while (*p) {
+        if (p[0] == '*' && p[1] == '*') {
+            while (*p == '*') p++;
+            if (*p == '\0')
+                return true;
+            // zero packages, the '/' before ** is already consumed
+            if (*p == '/' && class_filter_glob(p + 1, s))
+                return true;
+            for (; *s; s++) {
+                if (class_filter_glob(p, s))
+                    return true;
+            }
+            return false;
+        }
+        if (*p == '*') {
+            p++;
+            for (;; s++) {
+                if (class_filter_glob(p, s))
+                    return true;
+                if (*s == '\0' || *s == '/')
+                    return false;
+            }
+        }
+        if (*s == '\0')
+            return false;
+        if (*p != '?' && *p != *s)
+            return false;
+        if (*p == '?' && *s == '/')
+            return false;
+        p++;
+        s++;
+    }
+    return *s == '\0';
+}
+
+static bool class_filter_pattern_match(const char *pattern, const char *name)
+{
+    if (strpbrk(pattern, "*?") != NULL)
+        return class_filter_glob(pattern, name);
+
+    // a plain pattern is a package or a class with its nested classes
+    size_t len = strlen(pattern);
+    if (len > 0 && pattern[len-1] == '/')
+        len--;
+    if (strncmp(pattern, name, len) != 0)
+        return false;
+    return name[len] == '\0' || name[len] == '/' || name[len] == '$';
+}
+
+static bool class_filter_list_match(class_filter_list *list, const char *name)
+{
+    for (int i = 0; i < list->size; ++i) {
+        if (class_filter_pattern_match(list->patterns[i], name))
+            return true;
+    }
+    return false;
+}
+
+bool class_filter_match(const char *name)
+{
+    if (!class_filter_enabled())
+        return true;
+
+    char buf[1024];
+    size_t len = strlen(name);
+    if (len > 0 && name[0] == 'L' && name[len-1] == ';') {
+        name++;
+        len -= 2;
+    }
+    else if (len > 6 && strcmp(name + len - 6, ".class") == 0) {
+        len -= 6;
+    }
+    if (len >= sizeof(buf))
+        len = sizeof(buf) - 1;
+    memcpy(buf, name, len);
+    buf[len] = '\0';
+
+    if (filter_includes.size > 0 &&
+        !class_filter_list_match(&filter_includes, buf))
+        return false;
+    return !class_filter_list_match(&filter_excludes, buf);
+}
+
+bool class_filter_match_nested(const char *name)
+{
+    return filter_includes.size > 0 && class_filter_match(name);
+}
@@ -0,0 +1,31 @@
+#ifndef GARLIC_CLASS_FILTER_H
+#define GARLIC_CLASS_FILTER_H
+
+#include "common/types.h"
+
+/**
+ * include/exclude filter for the top level classes of a jar/dex/apk,
+ * a pattern is a package or class prefix (com.foo, com/foo/Bar) or a
+ * glob, '*' and '?' stay inside one package, '**' crosses packages.
+ * no include pattern means every class is included
+ **/
+
+void class_filter_include(const char *pattern);
+
+void class_filter_exclude(const char *pattern);
+
+bool class_filter_enabled();
+
+/**
+ * name may be a descriptor (Lcom/foo/Bar;), a jar entry path
+ * (com/foo/Bar.class) or an internal name (com/foo/Bar)
+ **/
+bool class_filter_match(const char *name);
+
+/**
+ * an inner/anonymous class picked by an include pattern pulls its top
+ * level class in, it is decompiled inside that class's task
+ **/
+bool class_filter_match_nested(const char *name);
+
+#endif //GARLIC_CLASS_FILTER_H
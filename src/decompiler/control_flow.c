@@ -88,9 +88,9 @@ jd_edge* create_link_edge(jd_bblock *source, jd_bblock *target)
 
 static void basic_block_init_common_object(jd_bblock *block)
 {
-    block->in = linit_object_with_capacity(2);
-    block->out = linit_object_with_capacity(2);
-    block->dom_children = linit_object();
+    block->in = linit_obj_small();
+    block->out = linit_obj_small();
+    block->dom_children = linit_obj_small();
     block->frontier = linit_object_with_capacity(2);
     block->frontier->cmp_fn = (list_cmp_fn) basic_block_id_comparator;
     block->dominates = linit_object();
@@ -146,18 +146,161 @@ jd_bblock* block_by_id(jd_method *m, int block_id)
     return NULL;
 }
 
-jd_bblock* block_handler_equals_offset(jd_method *m, uint32_t offset)
+/**
+ * offset -> basic block index of a method. the blocks are only appended
+ * to basic_blocks and their offsets do not change after that, so the
+ * index catches up with the new blocks instead of being rebuilt.
+ * the dense arrays keep the first block in basic_blocks order, the
+ * exception blocks are sorted by (offset, block_id) for the range queries
+ **/
+struct jd_block_index {
+    int         size;
+    uint32_t    offsets;
+    jd_bblock   **by_offset;
+    jd_bblock   **by_start;
+    jd_bblock   **by_handler;
+
+    int         exceptions_size;
+    int         exceptions_capacity;
+    int         sorted_size;
+    jd_bblock   **exceptions;
+    jd_bblock   **by_try_start;
+    jd_bblock   **by_handler_start;
+};
+
+static int cmp_block_try_start(const void *a, const void *b)
+{
+    jd_bblock *x = *(jd_bblock**)a;
+    jd_bblock *y = *(jd_bblock**)b;
+    uint32_t xs = x->ub->eblock->try_start_offset;
+    uint32_t ys = y->ub->eblock->try_start_offset;
+    if (xs != ys)
+        return xs < ys ? -1 : 1;
+    return x->block_id < y->block_id ? -1 : x->block_id > y->block_id;
+}
+
+static int cmp_block_handler_start(const void *a, const void *b)
+{
+    jd_bblock *x = *(jd_bblock**)a;
+    jd_bblock *y = *(jd_bblock**)b;
+    uint32_t xs = x->ub->eblock->handler_start_offset;
+    uint32_t ys = y->ub->eblock->handler_start_offset;
+    if (xs != ys)
+        return xs < ys ? -1 : 1;
+    return x->block_id < y->block_id ? -1 : x->block_id > y->block_id;
+}
+
+static void block_index_grow(jd_block_index *bi, uint32_t max_offset)
+{
+    if (max_offset < bi->offsets)
+        return;
+    uint32_t size = bi->offsets == 0 ? 64 : bi->offsets;
+    while (size <= max_offset)
+        size *= 2;
+    size_t old_bytes = sizeof(jd_bblock*) * bi->offsets;
+    size_t new_bytes = sizeof(jd_bblock*) * size;
+    bi->by_offset = x_realloc(bi->by_offset, old_bytes, new_bytes);
+    bi->by_start = x_realloc(bi->by_start, old_bytes, new_bytes);
+    bi->by_handler = x_realloc(bi->by_handler, old_bytes, new_bytes);
+    bi->offsets = size;
+}
+
+static void block_index_add_exception(jd_block_index *bi, jd_bblock *block)
+{
+    if (bi->exceptions_size == bi->exceptions_capacity) {
+        int capacity = bi->exceptions_capacity == 0 ?
+                       8 : bi->exceptions_capacity * 2;
+        size_t old_bytes = sizeof(jd_bblock*) * bi->exceptions_capacity;
+        size_t new_bytes = sizeof(jd_bblock*) * capacity;
+        bi->exceptions = x_realloc(bi->exceptions, old_bytes, new_bytes);
+        bi->by_try_start = x_realloc(bi->by_try_start, old_bytes, new_bytes);
+        bi->by_handler_start = x_realloc(bi->by_handler_start,
+                                         old_bytes,
+                                         new_bytes);
+        bi->exceptions_capacity = capacity;
+    }
+    bi->exceptions[bi->exceptions_size++] = block;
+}
+
+static jd_block_index* block_index(jd_method *m)
 {
-    for (int i = 0; i < m->basic_blocks->size; ++i) {
-        jd_bblock *basic_block = lget_obj(m->basic_blocks, i);
-        if (basic_block->type != JD_BB_EXCEPTION)
-            continue;
+    jd_block_index *bi = m->block_index;
+    if (bi == NULL) {
+        bi = make_obj(jd_block_index);
+        m->block_index = bi;
+    }
+    list_object *blocks = m->basic_blocks;
+    if (bi->size == blocks->size)
+        return bi;
 
-        jd_eblock *eblock = basic_block->ub->eblock;
-        if (eblock->handler_start_offset == offset)
-            return basic_block;
+    uint32_t max_offset = 0;
+    for (int i = bi->size; i < blocks->size; ++i) {
+        jd_bblock *block = lget_obj(blocks, i);
+        if (block->type == JD_BB_NORMAL) {
+            uint32_t end = block->ub->nblock->end_offset;
+            if (end > max_offset)
+                max_offset = end;
+        }
+        else if (block->type == JD_BB_EXCEPTION) {
+            uint32_t start = block->ub->eblock->handler_start_offset;
+            if (start > max_offset)
+                max_offset = start;
+        }
     }
-    return NULL;
+    block_index_grow(bi, max_offset);
+
+    for (int i = bi->size; i < blocks->size; ++i) {
+        jd_bblock *block = lget_obj(blocks, i);
+        if (block->type == JD_BB_NORMAL) {
+            jd_nblock *nblock = block->ub->nblock;
+            if (bi->by_start[nblock->start_offset] == NULL)
+                bi->by_start[nblock->start_offset] = block;
+            for (uint32_t off = nblock->start_offset;
+                 off <= nblock->end_offset; ++off) {
+                if (bi->by_offset[off] == NULL)
+                    bi->by_offset[off] = block;
+            }
+        }
+        else if (block->type == JD_BB_EXCEPTION) {
+            jd_eblock *eblock = block->ub->eblock;
+            if (bi->by_handler[eblock->handler_start_offset] == NULL)
+                bi->by_handler[eblock->handler_start_offset] = block;
+            block_index_add_exception(bi, block);
+        }
+    }
+    bi->size = blocks->size;
+
+    if (bi->sorted_size != bi->exceptions_size) {
+        size_t bytes = sizeof(jd_bblock*) * bi->exceptions_size;
+        memcpy(bi->by_try_start, bi->exceptions, bytes);
+        memcpy(bi->by_handler_start, bi->exceptions, bytes);
+        qsort(bi->by_try_start, bi->exceptions_size,
+              sizeof(jd_bblock*), cmp_block_try_start);
+        qsort(bi->by_handler_start, bi->exceptions_size,
+              sizeof(jd_bblock*), cmp_block_handler_start);
+        bi->sorted_size = bi->exceptions_size;
+    }
+    return bi;
+}
+
+static void block_index_reset(jd_method *m)
+{
+    jd_block_index *bi = m->block_index;
+    if (bi == NULL)
+        return;
+    size_t bytes = sizeof(jd_bblock*) * bi->offsets;
+    memset(bi->by_offset, 0, bytes);
+    memset(bi->by_start, 0, bytes);
+    memset(bi->by_handler, 0, bytes);
+    bi->size = 0;
+    bi->exceptions_size = 0;
+    bi->sorted_size = 0;
+}
+
+jd_bblock* block_handler_equals_offset(jd_method *m, uint32_t offset)
+{
+    jd_block_index *bi = block_index(m);
+    return offset < bi->offsets ? bi->by_handler[offset] : NULL;
 }
 
 jd_bblock* block_handler_equals_ins(jd_method *m, jd_ins *ins)
@@ -167,15 +310,8 @@ jd_bblock* block_handler_equals_ins(jd_method *m, jd_ins *ins)
 
 jd_bblock* block_start_offset(jd_method *m, uint32_t offset)
 {
-    for (int i = 0; i < m->basic_blocks->size; ++i) {
-        jd_bblock *block = lget_obj(m->basic_blocks, i);
-        if (block->type == JD_BB_NORMAL) {
-            jd_nblock *nblock = block->ub->nblock;
-            if (nblock->start_offset == offset)
-                return block;
-        }
-    }
-    return NULL;
+    jd_block_index *bi = block_index(m);
+    return offset < bi->offsets ? bi->by_start[offset] : NULL;
 }
 
 jd_bblock* block_contains_idx(jd_method *m, int idx)
@@ -201,75 +337,104 @@ jd_bblock* exp_block(jd_exp *exp)
 
 jd_bblock* block_closest_finally(jd_method *m, jd_bblock *e)
 {
+    jd_block_index *bi = block_index(m);
+    uint32_t try_start = e->ub->eblock->try_start_offset;
+
+    // first of the finally blocks with this try start
+    int lo = 0;
+    int hi = bi->exceptions_size;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        jd_eblock *eblock = bi->by_try_start[mid]->ub->eblock;
+        if (eblock->try_start_offset < try_start)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
     jd_bblock *closest_finally = NULL;
-    jd_eblock *eblock = e->ub->eblock;
-    for (int j = 0; j < m->basic_blocks->size; ++j) {
-        jd_bblock *other = lget_obj(m->basic_blocks, j);
-        if (other->type != JD_BB_EXCEPTION)
-            continue;
+    for (int i = lo; i < bi->exceptions_size; ++i) {
+        jd_bblock *other = bi->by_try_start[i];
         jd_eblock *_oe = other->ub->eblock;
-
-        if (_oe->try_start_offset == eblock->try_start_offset &&
-            _oe->type == JD_EXCEPTION_FINALLY) {
-            if (closest_finally == NULL)
-                closest_finally = other;
-            else {
-                jd_eblock *_ce = closest_finally->ub->eblock;
-                if (_oe->handler_start_offset > _ce->handler_start_offset)
-                    closest_finally = other;
-                if (_oe->handler_start_offset == _ce->handler_start_offset &&
-                    _oe->handler_end_offset < _ce->handler_end_offset)
-                    closest_finally = other;
-            }
+        if (_oe->try_start_offset != try_start)
+            break;
+        if (_oe->type != JD_EXCEPTION_FINALLY)
+            continue;
+        if (closest_finally == NULL) {
+            closest_finally = other;
+            continue;
         }
+        jd_eblock *_ce = closest_finally->ub->eblock;
+        if (_oe->handler_start_offset > _ce->handler_start_offset ||
+            (_oe->handler_start_offset == _ce->handler_start_offset &&
+             _oe->handler_end_offset < _ce->handler_end_offset))
+            closest_finally = other;
     }
     return closest_finally;
 }
 
 jd_bblock* block_closest_handler(jd_method *m, jd_bblock *block)
 {
-    jd_bblock *result = NULL;
+    jd_block_index *bi = block_index(m);
     jd_nblock *nblock = block->ub->nblock;
-    for (int i = 0; i < m->basic_blocks->size; ++i) {
-        jd_bblock *other_block = lget_obj(m->basic_blocks, i);
-        if (other_block->type != JD_BB_EXCEPTION)
-            continue;
-        jd_eblock *other = other_block->ub->eblock;
-        if (other->handler_start_offset <= nblock->start_offset &&
-            other->handler_end_offset >= nblock->end_offset) {
-            if (result == NULL) {
-                result = other_block;
+
+    // past the last handler starting at or before the block
+    int lo = 0;
+    int hi = bi->exceptions_size;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        jd_eblock *eblock = bi->by_handler_start[mid]->ub->eblock;
+        if (eblock->handler_start_offset <= nblock->start_offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    // the closest handler start wins, then the smallest handler end
+    int end = lo;
+    while (end > 0) {
+        jd_eblock *last = bi->by_handler_start[end - 1]->ub->eblock;
+        uint32_t handler_start = last->handler_start_offset;
+        int begin = end - 1;
+        while (begin > 0 &&
+               bi->by_handler_start[begin - 1]->ub->eblock->
+                       handler_start_offset == handler_start)
+            begin--;
+
+        jd_bblock *result = NULL;
+        for (int i = begin; i < end; ++i) {
+            jd_bblock *other_block = bi->by_handler_start[i];
+            jd_eblock *other = other_block->ub->eblock;
+            if (other->handler_end_offset < nblock->end_offset)
                 continue;
-            }
-            jd_eblock *eblock = result->ub->eblock;
-            if (other->handler_start_offset > eblock->handler_start_offset)
-                result = other_block;
-            if (other->handler_start_offset == eblock->handler_start_offset &&
-                other->handler_end_offset < eblock->handler_end_offset)
+            if (result == NULL ||
+                other->handler_end_offset <
+                result->ub->eblock->handler_end_offset)
                 result = other_block;
         }
+        if (result != NULL)
+            return result;
+        end = begin;
     }
-    return result;
+    return NULL;
 }
 
 jd_bblock* block_by_offset(jd_method *m, uint32_t offset)
 {
-    for (int i = 0; i < m->basic_blocks->size; ++i) {
-        jd_bblock *basic_block = lget_obj(m->basic_blocks, i);
-        if (basic_block->type == JD_BB_NORMAL) {
-            jd_nblock *nblock = basic_block->ub->nblock;
-            if (nblock->start_offset <= offset &&
-                nblock->end_offset >= offset)
-                return basic_block;
-        }
-        else if (basic_block->type == JD_BB_EXCEPTION) {
-            jd_eblock *eblock = basic_block->ub->eblock;
-            if (eblock->try_start_offset <= offset &&
-                eblock->try_end_offset >= offset)
-                return basic_block;
-        }
+    jd_block_index *bi = block_index(m);
+    jd_bblock *result = offset < bi->offsets ? bi->by_offset[offset] : NULL;
+
+    // an exception block before the normal one covers it with its try
+    for (int i = 0; i < bi->exceptions_size; ++i) {
+        jd_bblock *basic_block = bi->exceptions[i];
+        if (result != NULL && basic_block->block_id > result->block_id)
+            break;
+        jd_eblock *eblock = basic_block->ub->eblock;
+        if (eblock->try_start_offset <= offset &&
+            eblock->try_end_offset >= offset)
+            return basic_block;
     }
-    return NULL;
+    return result;
 }
 
 jd_bblock* block_exception_exit(jd_method *m)
@@ -320,9 +485,9 @@ jd_bblock* dup_basic_block(jd_method *m, jd_bblock *src)
     block->is_dup = true;
     block->node = NULL;
 
-    block->in = linit_object_with_capacity(2);
-    block->out = linit_object_with_capacity(2);
-    block->dom_children = linit_object();
+    block->in = linit_obj_small();
+    block->out = linit_obj_small();
+    block->dom_children = linit_obj_small();
     block->frontier = linit_object_with_capacity(2);
     block->frontier->cmp_fn = (list_cmp_fn) basic_block_id_comparator;
     block->dominates = linit_object();
@@ -569,9 +734,10 @@ static void cfg_create_normal_blocks(jd_method *m)
 
     int block_id = NORMAL_BLOCK_START_ID;
     jd_ins_fn *fn = get_ins(m, 0)->fn;
+    jd_exc_intervals *tries = exception_try_intervals(m->cfg_exceptions);
     for (int i = 0; i < m->instructions->size; ++i) {
         jd_ins *start_ins = get_ins(m, i);
-        jd_exc *start_exc = closest_exception_of(m, start_ins->offset);
+        jd_exc *start_exc = closest_exception_of(tries, start_ins->offset);
 
         jd_bblock *basic_block = cfg_create_basic_block(m,
                                                         block_id,
@@ -583,7 +749,7 @@ static void cfg_create_normal_blocks(jd_method *m)
             ins->block = basic_block;
             if (next_ins != NULL) {
                 off = next_ins->offset;
-                jd_exc *next_exc = closest_exception_of(m, off);
+                jd_exc *next_exc = closest_exception_of(tries, off);
 
                 if (start_exc != next_exc) {
                     i = j;
@@ -789,6 +955,7 @@ void cfg_create(jd_method *m)
         m->basic_blocks = linit_object();
     else
         lclear_object(m->basic_blocks);
+    block_index_reset(m);
 
     cfg_create_normal_blocks(m);
 
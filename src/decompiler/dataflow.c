@@ -0,0 +1,182 @@
+#include "decompiler/dataflow.h"
+#include "decompiler/control_flow.h"
+
+static inline bool dataflow_block_is_node(jd_bblock *block)
+{
+    return block->type == JD_BB_NORMAL;
+}
+
+static inline bitset_t* dataflow_set_of(list_object *sets, size_t block_id)
+{
+    return block_id < sets->size ? lget_obj(sets, block_id) : NULL;
+}
+
+/**
+ * post order of the cfg, every block not reached yet starts a new dfs.
+ * order[] gets basic_blocks indexes
+ **/
+static int dataflow_post_order(jd_method *m, int *order, int *stack,
+                               int *next_edge, u1 *seen)
+{
+    int size = 0;
+    for (int i = 0; i < m->basic_blocks->size; ++i) {
+        if (seen[i])
+            continue;
+        int top = 0;
+        stack[0] = i;
+        next_edge[0] = 0;
+        seen[i] = 1;
+        while (top >= 0) {
+            jd_bblock *block = lget_obj(m->basic_blocks, stack[top]);
+            if (next_edge[top] < block->out->size) {
+                jd_edge *edge = lget_obj(block->out, next_edge[top]++);
+                size_t target = edge->target_block_id;
+                if (target >= m->basic_blocks->size || seen[target])
+                    continue;
+                seen[target] = 1;
+                top++;
+                stack[top] = (int)target;
+                next_edge[top] = 0;
+                continue;
+            }
+            order[size++] = stack[top];
+            top--;
+        }
+    }
+    return size;
+}
+
+static void dataflow_grow_sets(list_object *sets, size_t words)
+{
+    if (sets == NULL)
+        return;
+    for (int i = 0; i < sets->size; ++i) {
+        bitset_t *set = lget_obj(sets, i);
+        if (set->arraysize < words)
+            bitset_grow(set, words);
+    }
+}
+
+static size_t dataflow_max_words(list_object *sets, size_t words)
+{
+    if (sets == NULL)
+        return words;
+    for (int i = 0; i < sets->size; ++i) {
+        bitset_t *set = lget_obj(sets, i);
+        if (set->arraysize > words)
+            words = set->arraysize;
+    }
+    return words;
+}
+
+/**
+ * recompute meet and result of block i in place,
+ * returns true when the result changed
+ **/
+static bool dataflow_transfer(jd_dataflow *df, jd_bblock *block, int i,
+                              size_t words)
+{
+    uint64_t *meet = ((bitset_t*)lget_obj(df->meets, i))->array;
+    uint64_t *result = ((bitset_t*)lget_obj(df->results, i))->array;
+    uint64_t *gen = ((bitset_t*)lget_obj(df->gens, i))->array;
+    uint64_t *kill = df->kills != NULL ?
+                     ((bitset_t*)lget_obj(df->kills, i))->array : NULL;
+
+    bool backward = df->direction == JD_DATAFLOW_BACKWARD;
+    list_object *edges = backward ? block->out : block->in;
+    memset(meet, 0, sizeof(uint64_t) * words);
+    for (int j = 0; j < edges->size; ++j) {
+        jd_edge *edge = lget_obj(edges, j);
+        size_t id = backward ? edge->target_block_id : edge->source_block_id;
+        bitset_t *other = dataflow_set_of(df->results, id);
+        if (other == NULL)
+            continue;
+        uint64_t *words_other = other->array;
+        for (size_t w = 0; w < words; ++w)
+            meet[w] |= words_other[w];
+    }
+
+    bool changed = false;
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t value = meet[w];
+        if (kill != NULL)
+            value &= ~kill[w];
+        value |= gen[w];
+        if (value != result[w]) {
+            result[w] = value;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void dataflow_solve(jd_method *m, jd_dataflow *df)
+{
+    int size = m->basic_blocks->size;
+    if (size == 0)
+        return;
+
+    // the word loops below need every set to have the same size
+    size_t words = dataflow_max_words(df->meets, 1);
+    words = dataflow_max_words(df->results, words);
+    words = dataflow_max_words(df->gens, words);
+    words = dataflow_max_words(df->kills, words);
+    dataflow_grow_sets(df->meets, words);
+    dataflow_grow_sets(df->results, words);
+    dataflow_grow_sets(df->gens, words);
+    dataflow_grow_sets(df->kills, words);
+
+    mem_pool *pool = x_current_pool();
+    int *order = make_obj_arr(int, size);
+    int *stack = make_obj_arr(int, size);
+    int *next_edge = make_obj_arr(int, size);
+    u1 *queued = make_obj_arr(u1, size);
+    // a ring of at most size blocks, queued[] keeps a block in it once
+    int *queue = make_obj_arr(int, size);
+
+    int order_size = dataflow_post_order(m, order, stack, next_edge, queued);
+    memset(queued, 0, size);
+
+    bool backward = df->direction == JD_DATAFLOW_BACKWARD;
+    int head = 0;
+    int count = 0;
+    for (int k = 0; k < order_size; ++k) {
+        int i = backward ? order[k] : order[order_size - k - 1];
+        jd_bblock *block = lget_obj(m->basic_blocks, i);
+        if (!dataflow_block_is_node(block))
+            continue;
+        queue[count++] = i;
+        queued[i] = 1;
+    }
+
+    while (count > 0) {
+        int i = queue[head];
+        head = (head + 1) % size;
+        count--;
+        queued[i] = 0;
+
+        jd_bblock *block = lget_obj(m->basic_blocks, i);
+        if (!dataflow_transfer(df, block, i, words))
+            continue;
+
+        // the neighbours reading this result have to be revisited
+        list_object *edges = backward ? block->in : block->out;
+        for (int j = 0; j < edges->size; ++j) {
+            jd_edge *edge = lget_obj(edges, j);
+            jd_bblock *other = backward ?
+                               edge->source_block : edge->target_block;
+            size_t id = other->block_id;
+            if (id >= size || queued[id] || !dataflow_block_is_node(other))
+                continue;
+            queued[id] = 1;
+            queue[(head + count) % size] = (int)id;
+            count++;
+        }
+    }
+
+    mem_pool_release(pool, order, sizeof(int) * size);
+    mem_pool_release(pool, stack, sizeof(int) * size);
+    mem_pool_release(pool, next_edge, sizeof(int) * size);
+    mem_pool_release(pool, queued, sizeof(u1) * size);
+    mem_pool_release(pool, queue, sizeof(int) * size);
+}
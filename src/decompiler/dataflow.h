@@ -0,0 +1,36 @@
+#ifndef GARLIC_DATAFLOW_H
+#define GARLIC_DATAFLOW_H
+
+#include "decompiler/structure.h"
+
+/**
+ * bit vector dataflow over the normal basic blocks of a method:
+ *
+ *   meet[b]   = U result[n], n: successors (backward) / predecessors (forward)
+ *   result[b] = gen[b] U (meet[b] - kill[b])
+ *
+ * liveness is backward with meet = live out, result = live in,
+ * reaching definitions is forward with meet = reaching in,
+ * result = reaching out.
+ *
+ * every list holds one bitset per basic_blocks index, neighbours are
+ * looked up by block_id. the sets are updated in place, a worklist in
+ * post order (backward) or reverse post order (forward) only revisits
+ * the blocks whose neighbours changed. kills may be NULL
+ **/
+typedef enum {
+    JD_DATAFLOW_FORWARD     = 0,
+    JD_DATAFLOW_BACKWARD    = 1,
+} jd_dataflow_direction;
+
+typedef struct {
+    jd_dataflow_direction   direction;
+    list_object             *meets;
+    list_object             *results;
+    list_object             *gens;
+    list_object             *kills;
+} jd_dataflow;
+
+void dataflow_solve(jd_method *m, jd_dataflow *df);
+
+#endif //GARLIC_DATAFLOW_H
@@ -1,35 +1,54 @@
 #include "decompiler/dominator_tree.h"
 #include "decompiler/control_flow.h"
 
-static int compute_dominance_frontier_callback(jd_bblock *block)
+/**
+ * seen is all zero on entry and on return, it only dedups the frontier
+ * of this block, the list keeps the order ladd_obj_no_dup produced.
+ * frontiers stay lists, ssa places its phi nodes in this order
+ **/
+static void compute_dominance_frontier(jd_bblock *block, bitset_t *seen)
 {
-    lclear_object(block->frontier);
+    list_object *frontier = block->frontier;
+    lclear_object(frontier);
 
     for (int i = 0; i < block->out->size; ++i) {
         jd_edge *edge = lget_obj(block->out, i);
         jd_bblock *target_block = edge->target_block;
-        if (target_block->idom != block)
-            ladd_obj_no_dup(block->frontier, target_block);
+        if (target_block->idom != block &&
+            !bitset_get(seen, target_block->block_id)) {
+            bitset_set(seen, target_block->block_id);
+            ladd_obj(frontier, target_block);
+        }
     }
 
     for (int i = 0; i < block->dom_children->size; ++i) {
         jd_bblock *child_block = lget_obj(block->dom_children, i);
         for (int j = 0; j < child_block->frontier->size; ++j) {
             jd_bblock *frontier_block = lget_obj(child_block->frontier, j);
-            if (frontier_block->idom != block)
-                ladd_obj_no_dup(block->frontier, frontier_block);
+            if (frontier_block->idom != block &&
+                !bitset_get(seen, frontier_block->block_id)) {
+                bitset_set(seen, frontier_block->block_id);
+                ladd_obj(frontier, frontier_block);
+            }
         }
     }
-    return 0;
-}
 
-static void post_order_traversal(jd_bblock *block, traversal_cb cb);
+    for (int i = 0; i < frontier->size; ++i) {
+        jd_bblock *frontier_block = lget_obj(frontier, i);
+        bitset_set_to_value(seen, frontier_block->block_id, false);
+    }
+}
 
 bool dominates(const jd_bblock *check, const jd_bblock *other)
 {
     if (check->block_id == other->block_id)
         return true;
 
+    if (check->dom_pre > 0 && other->dom_pre > 0)
+        return check->dom_pre < other->dom_pre &&
+               other->dom_post < check->dom_post;
+
+    // blocks added or cut off after the numbering walk the idom chain
     jd_bblock *_tmp = other->idom;
     while (_tmp != NULL) {
         if (_tmp->block_id == check->block_id)
@@ -43,12 +62,43 @@ void dominance_frontier(jd_method *m)
 {
     basic_block_clear_visited_flag(m);
 
+    size_t size = m->basic_blocks->size;
+    if (size == 0)
+        return;
+    mem_pool *pool = x_current_pool();
+    jd_bblock **stack = make_obj_arr(jd_bblock*, size);
+    int *next_child = make_obj_arr(int, size);
+    bitset_t *seen = bitset_create_with_capacity(size);
+
+    // post order of the dominator forest, children before their idom
     for (int i = 0; i < m->basic_blocks->size; ++i) {
-        jd_bblock *block = lget_obj(m->basic_blocks, i);
-        if (!basic_block_is_live(block))
+        jd_bblock *root = lget_obj(m->basic_blocks, i);
+        if (root->visited || !basic_block_is_live(root))
             continue;
-        post_order_traversal(block, compute_dominance_frontier_callback);
+        int top = 0;
+        root->visited = 1;
+        stack[0] = root;
+        next_child[0] = 0;
+        while (top >= 0) {
+            jd_bblock *block = stack[top];
+            if (next_child[top] < block->dom_children->size) {
+                jd_bblock *child = lget_obj(block->dom_children,
+                                            next_child[top]++);
+                if (child->visited || !basic_block_is_live(child))
+                    continue;
+                child->visited = 1;
+                top++;
+                stack[top] = child;
+                next_child[top] = 0;
+                continue;
+            }
+            compute_dominance_frontier(block, seen);
+            top--;
+        }
     }
+
+    mem_pool_release(pool, stack, sizeof(jd_bblock*) * size);
+    mem_pool_release(pool, next_child, sizeof(int) * size);
 }
 
 void compute_dominates_block(jd_method *m, jd_bblock *block)
@@ -66,88 +116,6 @@ void compute_dominates_block(jd_method *m, jd_bblock *block)
     }
 }
 
-static int pre_order_traversal(jd_bblock *block, traversal_cb callback)
-{
-    if (block->visited)
-        return 0;
-    block->visited = 1;
-    int result = callback(block);
-    for (int i = 0; i < block->out->size; ++i) {
-        jd_edge *edge = lget_obj(block->out, i);
-        if (!edge->target_block->visited)
-            result |= pre_order_traversal(edge->target_block, callback);
-    }
-    return result;
-}
-
-static void post_order_traversal(jd_bblock *block, traversal_cb cb)
-{
-    if (block->visited || !basic_block_is_live(block)) return;
-    block->visited = 1;
-
-    for (int i = 0; i < block->dom_children->size; ++i) {
-        jd_bblock *child_block = lget_obj(block->dom_children, i);
-        post_order_traversal(child_block, cb);
-    }
-    cb(block);
-}
-
-static inline bool block_in_list(const jd_bblock *block, const jd_bblock *list)
-{
-    if (list == NULL)
-        return false;
-    if (list->block_id == block->block_id)
-        return true;
-
-    return block_in_list(block, list->idom);
-}
-
-static const jd_bblock* same_dom_block(const jd_bblock *b1, 
-                                       const jd_bblock *b2)
-{
-    if (b1 == NULL || b2 == NULL)
-        return NULL;
-    if (b1->block_id == b2->block_id)
-        return b1;
-
-    if (block_in_list(b1, b2->idom))
-        return b1;
-
-    return same_dom_block(b2, b1->idom);
-}
-
-static bool compute_dominator_cb(jd_bblock *block)
-{
-    jd_bblock *dominator_block = NULL;
-
-    for (int i = 0; i < block->in->size; ++i) {
-        jd_edge *edge = lget_obj(block->in, i);
-        jd_bblock *source_block = edge->source_block;
-        if (source_block->visited) {
-            dominator_block = source_block;
-            break;
-        }
-    }
-
-    for (int i = 0; i < block->in->size; ++i) {
-        jd_edge *edge = lget_obj(block->in, i);
-        jd_bblock *source_block = edge->source_block;
-        if (source_block->idom != NULL) {
-            jd_bblock *_tmp = NULL;
-            _tmp = (jd_bblock *) same_dom_block(dominator_block, source_block);
-            if (_tmp != NULL)
-                dominator_block = _tmp;
-        }
-    }
-
-    if (block->idom != dominator_block &&
-        block != dominator_block) {
-        block->idom = dominator_block;
-        return true;
-    }
-    return false;
-}
-
 static void dominate_blocks_v2(jd_method *m)
 {
     for (int i = 0; i < m->basic_blocks->size; ++i) {
@@ -187,35 +155,204 @@ void dominate_blocks(jd_method *m, jd_bblock *block)
     }
 }
 
-void dominator_tree(jd_method *m)
+// <editor-fold defaultstate="collapsed" desc="dominator tree">
+
+/**
+ * Cooper, Harvey, Kennedy: "A Simple, Fast Dominance Algorithm",
+ * over dense post order numbers instead of the idom chains.
+ *
+ * every live block not reached yet starts a new region, in basic_blocks
+ * order. the region's first block is its root, its idom stays NULL,
+ * and only edges inside the region count.
+ **/
+typedef struct {
+    jd_bblock   **blocks;       // post order number -> block
+    int         *order;         // block_id -> post order number, -1: unreached
+    int         *region;        // post order number -> its root's number
+    int         *idom;          // post order number -> idom's number, -1: none
+    int         size;
+    size_t      max_id;
+} jd_dom_order;
+
+static inline int dom_order_of(jd_dom_order *d, jd_bblock *block)
+{
+    return block->block_id <= d->max_id ? d->order[block->block_id] : -1;
+}
+
+static void dom_number_region(jd_dom_order *d,
+                              jd_bblock *root,
+                              jd_bblock **stack,
+                              int *next_edge)
+{
+    int first = d->size;
+    int top = 0;
+    stack[0] = root;
+    next_edge[0] = 0;
+    // -2: on the dfs stack, numbered when all its successors are
+    d->order[root->block_id] = -2;
+    while (top >= 0) {
+        jd_bblock *block = stack[top];
+        if (next_edge[top] < block->out->size) {
+            jd_edge *edge = lget_obj(block->out, next_edge[top]++);
+            jd_bblock *target = edge->target_block;
+            if (target->block_id > d->max_id ||
+                d->order[target->block_id] != -1)
+                continue;
+            d->order[target->block_id] = -2;
+            top++;
+            stack[top] = target;
+            next_edge[top] = 0;
+            continue;
+        }
+        d->order[block->block_id] = d->size;
+        d->blocks[d->size++] = block;
+        top--;
+    }
+
+    int root_order = d->size - 1;
+    for (int i = first; i < d->size; ++i)
+        d->region[i] = root_order;
+    d->idom[root_order] = root_order;
+}
+
+static inline int dom_intersect(const int *idom, int b1, int b2)
 {
-    jd_bblock *enter_block = block_enter(m);
-    enter_block->idom = enter_block;
-    int changed = 1;
-    int result_tmp = 0;
+    while (b1 != b2) {
+        while (b1 < b2)
+            b1 = idom[b1];
+        while (b2 < b1)
+            b2 = idom[b2];
+    }
+    return b1;
+}
+
+static void dom_compute_idoms(jd_dom_order *d)
+{
+    bool changed = true;
     while (changed) {
-        changed = 0;
-        basic_block_clear_visited_flag(m);
-        for (int i = 0; i < m->basic_blocks->size; ++i) {
-            jd_bblock *block = lget_obj(m->basic_blocks, i);
-            if (!basic_block_is_live(block))
+        changed = false;
+        // reverse post order, the roots are fixed
+        for (int i = d->size - 1; i >= 0; --i) {
+            if (d->region[i] == i)
                 continue;
-            result_tmp = pre_order_traversal(block, compute_dominator_cb);
-            changed |= result_tmp == 1;
+            jd_bblock *block = d->blocks[i];
+            int new_idom = -1;
+            for (int j = 0; j < block->in->size; ++j) {
+                jd_edge *edge = lget_obj(block->in, j);
+                int pred = dom_order_of(d, edge->source_block);
+                if (pred < 0 ||
+                    d->region[pred] != d->region[i] ||
+                    d->idom[pred] < 0)
+                    continue;
+                new_idom = new_idom < 0 ?
+                           pred : dom_intersect(d->idom, pred, new_idom);
+            }
+            if (new_idom != d->idom[i]) {
+                d->idom[i] = new_idom;
+                changed = true;
+            }
         }
     }
+}
+
+/**
+ * pre/post numbers of the dominator forest, a dominates b iff
+ * a's interval encloses b's. only blocks whose whole idom chain is in
+ * the dom_children lists are numbered, the others keep 0
+ **/
+static void dom_number_tree(jd_method *m, jd_bblock **stack, int *next_child)
+{
+    int counter = 0;
+    for (int i = 0; i < m->basic_blocks->size; ++i) {
+        jd_bblock *root = lget_obj(m->basic_blocks, i);
+        if (root->idom != NULL)
+            continue;
+        int top = 0;
+        stack[0] = root;
+        next_child[0] = 0;
+        root->dom_pre = ++counter;
+        while (top >= 0) {
+            jd_bblock *block = stack[top];
+            if (next_child[top] < block->dom_children->size) {
+                jd_bblock *child = lget_obj(block->dom_children,
+                                            next_child[top]++);
+                if (child->dom_pre > 0)
+                    continue;
+                child->dom_pre = ++counter;
+                top++;
+                stack[top] = child;
+                next_child[top] = 0;
+                continue;
+            }
+            block->dom_post = ++counter;
+            top--;
+        }
+    }
+}
+
+void dominator_tree(jd_method *m)
+{
+    size_t size = m->basic_blocks->size;
+    if (size == 0)
+        return;
+
+    jd_dom_order d = {0};
+    for (int i = 0; i < m->basic_blocks->size; ++i) {
+        jd_bblock *block = lget_obj(m->basic_blocks, i);
+        block->dom_pre = 0;
+        block->dom_post = 0;
+        if (block->block_id > d.max_id)
+            d.max_id = block->block_id;
+    }
+
+    mem_pool *pool = x_current_pool();
+    size_t order_size = sizeof(int) * (d.max_id + 1);
+    d.blocks = make_obj_arr(jd_bblock*, size);
+    d.order = x_alloc_raw(order_size);
+    memset(d.order, 0xff, order_size);
+    d.region = make_obj_arr(int, size);
+    d.idom = make_obj_arr(int, size);
+    jd_bblock **stack = make_obj_arr(jd_bblock*, size);
+    int *next_edge = make_obj_arr(int, size);
+    for (int i = 0; i < size; ++i)
+        d.idom[i] = -1;
+
+    for (int i = 0; i < m->basic_blocks->size; ++i) {
+        jd_bblock *block = lget_obj(m->basic_blocks, i);
+        if (!basic_block_is_live(block) || d.order[block->block_id] != -1)
+            continue;
+        dom_number_region(&d, block, stack, next_edge);
+    }
+
+    dom_compute_idoms(&d);
+
+    for (int i = 0; i < d.size; ++i) {
+        jd_bblock *block = d.blocks[i];
+        int idom = d.idom[i];
+        block->idom = idom < 0 || idom == i ? NULL : d.blocks[idom];
+    }
 
-    enter_block->idom = NULL;
     for (int i = 0; i < m->basic_blocks->size; ++i) {
         jd_bblock *block = lget_obj(m->basic_blocks, i);
         if (!basic_block_is_live(block))
             continue;
         jd_bblock *idom_block = block->idom;
         if (idom_block != NULL)
-            ladd_obj_no_dup(idom_block->dom_children, block);
+            ladd_obj(idom_block->dom_children, block);
     }
+
+    dom_number_tree(m, stack, next_edge);
+
+    mem_pool_release(pool, d.blocks, sizeof(jd_bblock*) * size);
+    mem_pool_release(pool, d.order, order_size);
+    mem_pool_release(pool, d.region, sizeof(int) * size);
+    mem_pool_release(pool, d.idom, sizeof(int) * size);
+    mem_pool_release(pool, stack, sizeof(jd_bblock*) * size);
+    mem_pool_release(pool, next_edge, sizeof(int) * size);
 }
 
+// </editor-fold>
+
 void create_dominator_tree(jd_method *m)
 {
     dominator_tree(m);
@@ -231,6 +368,8 @@ void clear_dominator_data(jd_method *m)
         lclear_object(block->dom_children);
         lclear_object(block->dominates);
         block->idom = NULL;
+        block->dom_pre = 0;
+        block->dom_post = 0;
     }
 }
 
@@ -242,6 +381,8 @@ void clear_dominator_tree(jd_method *m)
         lclear_object(block->frontier);
         lclear_object(block->dominates);
         block->idom = NULL;
+        block->dom_pre = 0;
+        block->dom_post = 0;
     }
     lclear_object(m->cfg_exceptions);
 }
@@ -0,0 +1,76 @@
+#include "decompiler/emitter.h"
+#include "decompiler/expression_writter.h"
+
+void emitter_init(jd_emitter *e, FILE *out)
+{
+    e->buf = malloc(EMITTER_INIT_CAPACITY);
+    e->size = 0;
+    e->capacity = EMITTER_INIT_CAPACITY;
+    e->out = out;
+    e->ident_node = NULL;
+    e->ident = 0;
+}
+
+void emitter_grow(jd_emitter *e, size_t need)
+{
+    size_t capacity = e->capacity;
+    while (e->size + need >= capacity)
+        capacity *= 2;
+    e->buf = realloc(e->buf, capacity);
+    e->capacity = capacity;
+}
+
+void emitter_flush(jd_emitter *e)
+{
+    if (e->out != NULL && e->size > 0)
+        fwrite(e->buf, 1, e->size, e->out);
+    e->size = 0;
+}
+
+void emitter_free(jd_emitter *e)
+{
+    free(e->buf);
+    e->buf = NULL;
+    e->size = 0;
+    e->capacity = 0;
+}
+
+/**
+ * copy of the emitted text in the current pool, for the callers that
+ * still want a string
+ **/
+string emitter_to_string(jd_emitter *e)
+{
+    string result = x_alloc(e->size + 1);
+    memcpy(result, e->buf, e->size);
+    result[e->size] = '\0';
+    return result;
+}
+
+void emit_printf(jd_emitter *e, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    size_t room = e->capacity - e->size;
+    int len = vsnprintf(e->buf + e->size, room, fmt, args);
+    va_end(args);
+    if (len < 0)
+        return;
+
+    if ((size_t)len >= room) {
+        emitter_grow(e, len);
+        va_start(args, fmt);
+        vsnprintf(e->buf + e->size, e->capacity - e->size, fmt, args);
+        va_end(args);
+    }
+    e->size += len;
+}
+
+void emit_ident(jd_emitter *e, jd_node *node)
+{
+    if (node != e->ident_node) {
+        e->ident_node = node;
+        e->ident = node_ident_level(node) * 4;
+    }
+    emit_spaces(e, e->ident);
+}
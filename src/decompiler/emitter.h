@@ -0,0 +1,79 @@
+#ifndef GARLIC_EMITTER_H
+#define GARLIC_EMITTER_H
+
+#include <stdarg.h>
+#include "decompiler/structure.h"
+
+/**
+ * the output buffer of one source file. the writer and the transformers
+ * append straight into it, nothing is formatted into a string first.
+ * the whole file is handed to its FILE* once by emitter_flush.
+ *
+ * ident_node/ident cache the indent of the last node, the statements of
+ * a block are written one after another with the same indent
+ **/
+typedef struct {
+    char        *buf;
+    size_t      size;
+    size_t      capacity;
+    FILE        *out;
+    jd_node     *ident_node;
+    int         ident;
+} jd_emitter;
+
+#define EMITTER_INIT_CAPACITY 16384
+
+void emitter_init(jd_emitter *e, FILE *out);
+
+void emitter_flush(jd_emitter *e);
+
+void emitter_free(jd_emitter *e);
+
+string emitter_to_string(jd_emitter *e);
+
+void emitter_grow(jd_emitter *e, size_t need);
+
+void emit_printf(jd_emitter *e, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+void emit_ident(jd_emitter *e, jd_node *node);
+
+static inline void emit_bytes(jd_emitter *e, const char *s, size_t len)
+{
+    if (e->size + len >= e->capacity)
+        emitter_grow(e, len);
+    memcpy(e->buf + e->size, s, len);
+    e->size += len;
+}
+
+static inline void emit_str(jd_emitter *e, const char *s)
+{
+    emit_bytes(e, s, strlen(s));
+}
+
+static inline void emit_char(jd_emitter *e, char c)
+{
+    if (e->size + 1 >= e->capacity)
+        emitter_grow(e, 1);
+    e->buf[e->size++] = c;
+}
+
+static inline void emit_spaces(jd_emitter *e, int count)
+{
+    if (count <= 0)
+        return;
+    if (e->size + count >= e->capacity)
+        emitter_grow(e, count);
+    memset(e->buf + e->size, ' ', count);
+    e->size += count;
+}
+
+// true when the bytes emitted since mark are exactly s
+static inline bool emit_since_equals(jd_emitter *e, size_t mark,
+                                     const char *s)
+{
+    size_t len = strlen(s);
+    return e->size - mark == len && memcmp(e->buf + mark, s, len) == 0;
+}
+
+#endif //GARLIC_EMITTER_H
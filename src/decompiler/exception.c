@@ -124,6 +124,10 @@ static inline bool exception_in_range(jd_range *s, uint32_t offset)
     return (offset >= s->start_offset && offset <= s->end_offset);
 }
 
+/**
+ * try_contains_cmp and handler_contains_cmp are no total order, the
+ * inline finally pass relies on the order this bubble sort leaves
+ **/
 static void buble_sort_exceptions(list_object *exceptions, list_cmp_fn fn)
 {
     int size = exceptions->size;
@@ -142,6 +146,202 @@ void buble_sort_cfg_exception(jd_method *m, list_cmp_fn fn)
     buble_sort_exceptions(m->cfg_exceptions, fn);
 }
 
+/**
+ * stable merge sort, fn(e1, e2) > 0 puts e1 after e2
+ **/
+static void merge_sort_exceptions(list_object *exceptions, list_cmp_fn fn)
+{
+    size_t size = exceptions->size;
+    if (size < 2)
+        return;
+    mem_pool *pool = x_current_pool();
+    void **data = (void**)exceptions->data;
+    void **tmp = make_obj_arr(void*, size);
+    for (size_t width = 1; width < size; width *= 2) {
+        for (size_t lo = 0; lo < size; lo += 2 * width) {
+            size_t mid = MIN(lo + width, size);
+            size_t hi = MIN(lo + 2 * width, size);
+            size_t l = lo, r = mid, k = lo;
+            while (l < mid && r < hi) {
+                if (fn(data[l], data[r]) > 0)
+                    tmp[k++] = data[r++];
+                else
+                    tmp[k++] = data[l++];
+            }
+            while (l < mid)
+                tmp[k++] = data[l++];
+            while (r < hi)
+                tmp[k++] = data[r++];
+        }
+        memcpy(data, tmp, sizeof(void*) * size);
+    }
+    mem_pool_release(pool, tmp, sizeof(void*) * size);
+}
+
+void sort_cfg_exception(jd_method *m, list_cmp_fn fn)
+{
+    merge_sort_exceptions(m->cfg_exceptions, fn);
+}
+
+/**
+ * try or handler ranges of an exception list sorted by start, with
+ * the max end of every subtree of the implicit balanced tree over the
+ * sorted array. a stabbing query only walks into the subtrees that can
+ * still cover the offset, the hits come back in list order so the
+ * passes keep picking the same exception as their linear scans.
+ * the ranges are copied, rebuild after moving a start or an end
+ **/
+typedef struct {
+    uint32_t    start;
+    uint32_t    end;
+    int         pos;
+    jd_exc      *exc;
+} jd_exc_interval;
+
+struct jd_exc_intervals {
+    list_object     *exceptions;
+    bool            handler;
+    int             size;
+    jd_exc_interval *items;
+    uint32_t        *max_end;
+
+    int             hits_size;
+    jd_exc_interval **hits;
+};
+
+static int exception_interval_cmp(const void *a, const void *b)
+{
+    const jd_exc_interval *x = a;
+    const jd_exc_interval *y = b;
+    if (x->start != y->start)
+        return x->start < y->start ? -1 : 1;
+    if (x->end != y->end)
+        return x->end < y->end ? -1 : 1;
+    return x->pos - y->pos;
+}
+
+static uint32_t exception_intervals_max(jd_exc_intervals *iv, int lo, int hi)
+{
+    if (lo >= hi)
+        return 0;
+    int mid = lo + (hi - lo) / 2;
+    uint32_t max = iv->items[mid].end;
+    uint32_t left = exception_intervals_max(iv, lo, mid);
+    uint32_t right = exception_intervals_max(iv, mid + 1, hi);
+    max = MAX(max, left);
+    max = MAX(max, right);
+    iv->max_end[mid] = max;
+    return max;
+}
+
+static void exception_intervals_rebuild(jd_exc_intervals *iv)
+{
+    list_object *exceptions = iv->exceptions;
+    if (iv->size < exceptions->size) {
+        iv->items = make_obj_arr(jd_exc_interval, exceptions->size);
+        iv->max_end = make_obj_arr(uint32_t, exceptions->size);
+        iv->hits = make_obj_arr(jd_exc_interval*, exceptions->size);
+    }
+    iv->size = exceptions->size;
+    for (int i = 0; i < iv->size; ++i) {
+        jd_exc *e = lget_obj(exceptions, i);
+        jd_exc_interval *item = &iv->items[i];
+        item->start = iv->handler ? e->handler_start : e->try_start;
+        item->end = iv->handler ? e->handler_end : e->try_end;
+        item->pos = i;
+        item->exc = e;
+    }
+    // items is still NULL for a method without exceptions
+    if (iv->size > 1)
+        qsort(iv->items, iv->size, sizeof(jd_exc_interval),
+              exception_interval_cmp);
+    exception_intervals_max(iv, 0, iv->size);
+    iv->hits_size = 0;
+}
+
+static jd_exc_intervals* exception_intervals(list_object *exceptions,
+                                             bool handler)
+{
+    jd_exc_intervals *iv = make_obj(jd_exc_intervals);
+    iv->exceptions = exceptions;
+    iv->handler = handler;
+    exception_intervals_rebuild(iv);
+    return iv;
+}
+
+jd_exc_intervals* exception_try_intervals(list_object *exceptions)
+{
+    return exception_intervals(exceptions, false);
+}
+
+static void exception_intervals_walk(jd_exc_intervals *iv,
+                                     int lo,
+                                     int hi,
+                                     uint32_t offset)
+{
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (iv->max_end[mid] < offset)
+            return;
+        exception_intervals_walk(iv, lo, mid, offset);
+        jd_exc_interval *item = &iv->items[mid];
+        if (item->start > offset)
+            return;
+        if (item->end >= offset) {
+            // keep the hits in list order, there are only a few of them
+            int k = iv->hits_size++;
+            while (k > 0 && iv->hits[k - 1]->pos > item->pos) {
+                iv->hits[k] = iv->hits[k - 1];
+                k--;
+            }
+            iv->hits[k] = item;
+        }
+        lo = mid + 1;
+    }
+}
+
+/**
+ * the exceptions whose range covers offset, into iv->hits
+ **/
+static int exception_intervals_stab(jd_exc_intervals *iv, uint32_t offset)
+{
+    iv->hits_size = 0;
+    exception_intervals_walk(iv, 0, iv->size, offset);
+    return iv->hits_size;
+}
+
+/**
+ * the exceptions with exactly this range, into iv->hits
+ **/
+static int exception_intervals_same(jd_exc_intervals *iv,
+                                    uint32_t start,
+                                    uint32_t end)
+{
+    int lo = 0;
+    int hi = iv->size;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        jd_exc_interval *item = &iv->items[mid];
+        if (item->start < start || (item->start == start && item->end < end))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    iv->hits_size = 0;
+    for (int i = lo; i < iv->size; ++i) {
+        jd_exc_interval *item = &iv->items[i];
+        if (item->start != start || item->end != end)
+            break;
+        iv->hits[iv->hits_size++] = item;
+    }
+    return iv->hits_size;
+}
+
+static inline jd_exc* exception_intervals_hit(jd_exc_intervals *iv, int i)
+{
+    return iv->hits[i]->exc;
+}
+
 //static void buble_sort_full_exception(jd_method *m, list_cmp_fn ins_fn)
 //{
 //    buble_sort_exceptions(m, m->closed_exceptions, ins_fn);
@@ -470,11 +670,15 @@ static void narrow_finally_block_near_catch_exception(jd_method *m)
 
 }
 
-static jd_exc* overlapping_try_with_handler_exception(jd_method *m, jd_exc *ex)
+static jd_exc* overlapping_try_with_handler_exception(jd_method *m,
+                                                      jd_exc_intervals *handlers,
+                                                      jd_exc *ex)
 {
     jd_exc *result = NULL;
-    for (int i = 0; i < m->closed_exceptions->size; ++i) {
-        jd_exc *other = lget_obj(m->closed_exceptions, i);
+    // only the handlers around the try start can overlap it
+    int hits = exception_intervals_stab(handlers, ex->try_start);
+    for (int i = 0; i < hits; ++i) {
+        jd_exc *other = exception_intervals_hit(handlers, i);
         jd_range source = init_try_block_range(ex);
         jd_range target = init_handler_block_range(other);
         jd_ins *_last_ins = get_ins(m, other->handler_end_idx);
@@ -503,9 +707,12 @@ static void fix_overlapping_try_with_handler_exception(jd_method *m)
     if (m->closed_exceptions->size == 0)
         return;
 
+    // only try starts move, the handler ranges stay as indexed
+    jd_exc_intervals *handlers = exception_intervals(m->closed_exceptions,
+                                                     true);
     for (int i = 0; i < m->closed_exceptions->size; ++i) {
         jd_exc *e = lget_obj(m->closed_exceptions, i);
-        jd_exc *other = overlapping_try_with_handler_exception(m, e);
+        jd_exc *other = overlapping_try_with_handler_exception(m, handlers, e);
         if (other == NULL)
             continue;
 
@@ -518,11 +725,14 @@ static void fix_overlapping_try_with_handler_exception(jd_method *m)
     }
 }
 
-static jd_exc* overlapping_try_with_try_exception(jd_method *m, jd_exc *ex)
+static jd_exc* overlapping_try_with_try_exception(jd_method *m,
+                                                  jd_exc_intervals *tries,
+                                                  jd_exc *ex)
 {
     jd_exc *result = NULL;
-    for (int i = 0; i < m->closed_exceptions->size; ++i) {
-        jd_exc *other = lget_obj(m->closed_exceptions, i);
+    int hits = exception_intervals_stab(tries, ex->try_start);
+    for (int i = 0; i < hits; ++i) {
+        jd_exc *other = exception_intervals_hit(tries, i);
         jd_range source = init_try_block_range(ex);
         jd_range target = init_try_block_range(other);
         jd_ins *_last_ins = get_ins(m, other->try_end_idx);
@@ -550,9 +760,11 @@ static void fix_overlapping_try_with_try_exception(jd_method *m)
 {
     if (m->closed_exceptions->size == 0)
         return;
+    jd_exc_intervals *tries = exception_intervals(m->closed_exceptions,
+                                                  false);
     for (int i = 0; i < m->closed_exceptions->size; ++i) {
         jd_exc *e = lget_obj(m->closed_exceptions, i);
-        jd_exc *other = overlapping_try_with_try_exception(m, e);
+        jd_exc *other = overlapping_try_with_try_exception(m, tries, e);
         if (other == NULL)
             continue;
 
@@ -572,37 +784,29 @@ static void fix_overlapping_try_with_try_exception(jd_method *m)
             e->try_end = min_end_offset;
             e->try_end_idx = other->try_end_idx;
         }
+        exception_intervals_rebuild(tries);
         i--;
     }
 }
 
-static jd_exc* same_try_exception_by_range(jd_method *m, jd_range *r)
+static jd_exc* same_try_exception_by_range(jd_exc_intervals *tries,
+                                           jd_range *r)
 {
-    jd_exc *result = NULL;
-    for (int i = 0; i < m->closed_exceptions->size; ++i) {
-        jd_exc *other = lget_obj(m->closed_exceptions, i);
-        if (other->try_start == r->start_offset &&
-            other->try_end == r->end_offset) {
-            result = other;
-            break;
-        }
-    }
-    return result;
+    int hits = exception_intervals_same(tries, r->start_offset, r->end_offset);
+    return hits > 0 ? exception_intervals_hit(tries, 0) : NULL;
 }
 
-static jd_exc* smallest_try_of_range(jd_method *m, jd_range *r)
+static jd_exc* smallest_try_of_range(jd_exc_intervals *tries, jd_range *r)
 {
     jd_exc *result = NULL;
-    for (int i = 0; i < m->closed_exceptions->size; ++i) {
-        jd_exc *other = lget_obj(m->closed_exceptions, i);
-        if (other->try_start == r->start_offset &&
-            other->try_end == r->end_offset) {
-            if (result == NULL)
+    int hits = exception_intervals_same(tries, r->start_offset, r->end_offset);
+    for (int i = 0; i < hits; ++i) {
+        jd_exc *other = exception_intervals_hit(tries, i);
+        if (result == NULL)
+            result = other;
+        else {
+            if (other->handler_start < result->handler_start)
                 result = other;
-            else {
-                if (other->handler_start < result->handler_start)
-                    result = other;
-            }
         }
     }
     return result;
@@ -612,11 +816,13 @@ static void fix_same_try_end_offset(jd_method *m)
 {
     if (m->closed_exceptions->size == 0)
         return;
+    jd_exc_intervals *tries = exception_intervals(m->closed_exceptions,
+                                                  false);
     for (int i = 0; i < m->closed_exceptions->size; ++i) {
         jd_exc *exception = lget_obj(m->closed_exceptions, i);
         jd_range range = init_try_block_range(exception);
-        jd_exc *other = same_try_exception_by_range(m, &range);
-        jd_exc *smallest = smallest_try_of_range(m, &range);
+        jd_exc *other = same_try_exception_by_range(tries, &range);
+        jd_exc *smallest = smallest_try_of_range(tries, &range);
 //         if (other == exception)
 //             continue;
         int small_idx = smallest->handler_start_idx;
@@ -627,7 +833,8 @@ static void fix_same_try_end_offset(jd_method *m)
             if (other->try_end != other_handler_start_prev->offset) {
                 other->try_end = other_handler_start_prev->offset;
                 other->try_end_idx = other_handler_start_prev->idx;
-                other = same_try_exception_by_range(m, &range);
+                exception_intervals_rebuild(tries);
+                other = same_try_exception_by_range(tries, &range);
             }
             else
                 other = NULL;
@@ -635,34 +842,33 @@ static void fix_same_try_end_offset(jd_method *m)
     }
 }
 
-static jd_exc* find_next_sibling(jd_method *m, jd_range *r, uint32_t offset)
+static jd_exc* find_next_sibling(jd_exc_intervals *tries,
+                                 jd_range *r,
+                                 uint32_t offset)
 {
-    jd_exc *result = NULL;
-    for (int i = 0; i < m->closed_exceptions->size; ++i) {
-        jd_exc *other = lget_obj(m->closed_exceptions, i);
-
-        if (other->handler_end <= offset)
-            continue;
-        if (other->try_start == r->start_offset &&
-            other->try_end == r->end_offset) {
-            result = other;
-            break;
-        }
+    int hits = exception_intervals_same(tries, r->start_offset, r->end_offset);
+    for (int i = 0; i < hits; ++i) {
+        jd_exc *other = exception_intervals_hit(tries, i);
+        if (other->handler_end > offset)
+            return other;
     }
-    return result;
+    return NULL;
 }
 
 static void make_sure_same_try_handler_consequent(jd_method *m)
 {
+    // only handler ends move, the try ranges stay as indexed
+    jd_exc_intervals *tries = exception_intervals(m->closed_exceptions,
+                                                  false);
     for (int i = 0; i < m->closed_exceptions->size; ++i) {
         jd_exc *exception = lget_obj(m->closed_exceptions, i);
         if (exception->catch_type_index > 0)
             continue;
         jd_range range = init_try_block_range(exception);
-        jd_exc *other = find_next_sibling(m, &range, 0);
+        jd_exc *other = find_next_sibling(tries, &range, 0);
         uint32_t _end_offset = other->handler_end;
         while (other != NULL) {
-            jd_exc *next = find_next_sibling(m,
+            jd_exc *next = find_next_sibling(tries,
                                              &range,
                                              _end_offset);
             if (next == NULL)
@@ -756,29 +962,29 @@ static void remove_duplicate_finally_for_try_block(jd_method *m)
     }
 }
 
-static jd_exc* find_first_handler(jd_method *m, jd_exc *e)
+static jd_exc* find_first_handler(jd_exc_intervals *tries, jd_exc *e)
 {
     jd_exc *result = NULL;
-    for (int i = 0; i < m->closed_exceptions->size; ++i) {
-        jd_exc *other = lget_obj(m->closed_exceptions, i);
-        if (other->try_start == e->try_start &&
-            other->try_end == e->try_end) {
-            if (result == NULL) {
-                result = other;
-                continue;
-            }
-            if (other->handler_start < result->handler_start)
-                result = other;
+    int hits = exception_intervals_same(tries, e->try_start, e->try_end);
+    for (int i = 0; i < hits; ++i) {
+        jd_exc *other = exception_intervals_hit(tries, i);
+        if (result == NULL) {
+            result = other;
+            continue;
         }
+        if (other->handler_start < result->handler_start)
+            result = other;
     }
     return result;
 }
 
 static void fix_same_try_edge(jd_method *m)
 {
+    jd_exc_intervals *tries = exception_intervals(m->closed_exceptions,
+                                                  false);
     for (int i = 0; i < m->closed_exceptions->size; ++i) {
         jd_exc *exception = lget_obj(m->closed_exceptions, i);
-        jd_exc *smallest = find_first_handler(m, exception);
+        jd_exc *smallest = find_first_handler(tries, exception);
         if (smallest == NULL)
             continue;
         jd_ins *exception_try_end = get_ins(m,
@@ -817,6 +1023,7 @@ static void fix_same_try_edge(jd_method *m)
                     same_try->try_end_idx = smallest_handler_start_prev->idx;
                 }
             }
+            exception_intervals_rebuild(tries);
         }
     }
 }
@@ -1101,6 +1308,24 @@ static void expand_synchronized_exception_block_range(jd_method *m)
     }
 }
 
+/**
+ * the overlap fixes, fix_same_try_end_offset, make_sure_same_try_handler_
+ * consequent and the lookup of fix_same_try_edge query the interval index,
+ * but the overlap fixes still restart their scan and rebuild the index
+ * after every range they move, which is quadratic in the worst case.
+ *
+ * these still scan closed_exceptions directly:
+ *   one pass, but each list removal shifts the rest:
+ *     remove_useless_finally_exception, remove_empty_catch_body_exception,
+ *     merge_exception_split_by_branch_without_finally
+ *   a full scan per entry (quadratic):
+ *     remove_share_handler_finally, remove_share_hanlder_catch,
+ *     merge_exception_split_by_branch_with_finally,
+ *     narrow_finally_block_near_catch_exception,
+ *     remove_duplicate_finally_for_try_block, the delete loop of
+ *     fix_same_try_edge, remove_crossed_finally_handler
+ *   cubic: remove_duplicate_finally_for_catch_block
+ **/
 void cleanup_full_exception_table(jd_method *m)
 {
     if (m->closed_exceptions->size == 0)
@@ -1163,10 +1388,7 @@ void cleanup_full_exception_table(jd_method *m)
 
 void flatten_exceptions(jd_method *m)
 {
-    buble_sort_cfg_exception(m, (list_cmp_fn) try_end_cmp);
-    buble_sort_cfg_exception(m, (list_cmp_fn) handler_end_cmp);
-    buble_sort_cfg_exception(m, (list_cmp_fn) handler_start_cmp);
-    buble_sort_cfg_exception(m, (list_cmp_fn) try_start_cmp);
+    sort_cfg_exception(m, (list_cmp_fn) try_handler_order_cmp);
 
 
 //     print_cfg_exception_table(m);
@@ -1253,28 +1475,25 @@ void flatten_exceptions(jd_method *m)
     }
 }
 
-jd_exc* closest_exception_of(jd_method *m, uint32_t offset)
+jd_exc* closest_exception_of(jd_exc_intervals *tries, uint32_t offset)
 {
     jd_exc *current = NULL;
-    for (int i = 0; i < m->cfg_exceptions->size; ++i) {
-        jd_exc *exception = lget_obj(m->cfg_exceptions, i);
-        if (offset >= exception->try_start &&
-            offset <= exception->try_end) {
-            if (current == NULL) {
-                current = exception;
-                continue;
-            }
-            if (exception->start_pc > current->start_pc)
-                current = exception;
-            if (exception->start_pc == current->start_pc &&
-                exception->end_pc < current->end_pc)
-                current = exception;
-
-            if (exception->try_start >= current->try_start &&
-                exception->try_end <= current->try_end)
-                current = exception;
+    int hits = exception_intervals_stab(tries, offset);
+    for (int i = 0; i < hits; ++i) {
+        jd_exc *exception = exception_intervals_hit(tries, i);
+        if (current == NULL) {
+            current = exception;
+            continue;
         }
-
+        if (exception->start_pc > current->start_pc)
+            current = exception;
+        if (exception->start_pc == current->start_pc &&
+            exception->end_pc < current->end_pc)
+            current = exception;
+
+        if (exception->try_start >= current->try_start &&
+            exception->try_end <= current->try_end)
+            current = exception;
     }
     return current;
 }
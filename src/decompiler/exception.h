@@ -16,7 +16,11 @@ void flatten_exceptions(jd_method *m);
 
 void pullin_block_jump_into_exception_try_block(jd_method *m);
 
-jd_exc* closest_exception_of(jd_method *m, uint32_t offset);
+typedef struct jd_exc_intervals jd_exc_intervals;
+
+jd_exc_intervals* exception_try_intervals(list_object *exceptions);
+
+jd_exc* closest_exception_of(jd_exc_intervals *tries, uint32_t offset);
 
 
 // exception sort
@@ -46,6 +50,21 @@ static inline int try_end_cmp(jd_exc *e1, jd_exc *e2)
     return e1->try_end > e2->try_end ? 1 : 0;
 }
 
+// one stable sort instead of sorting by try end, handler end,
+// handler start and then try start
+static inline int try_handler_order_cmp(jd_exc *e1, jd_exc *e2)
+{
+    if (e1->try_start != e2->try_start)
+        return e1->try_start > e2->try_start ? 1 : -1;
+    if (e1->handler_start != e2->handler_start)
+        return e1->handler_start > e2->handler_start ? 1 : -1;
+    if (e1->handler_end != e2->handler_end)
+        return e1->handler_end > e2->handler_end ? 1 : -1;
+    if (e1->try_end != e2->try_end)
+        return e1->try_end > e2->try_end ? 1 : -1;
+    return 0;
+}
+
 static inline int try_contains_cmp(jd_exc *e1, jd_exc *e2)
 {
     return e1->try_start <= e2->try_start &&
@@ -60,4 +79,6 @@ static inline int handler_contains_cmp(jd_exc *e1, jd_exc *e2)
 
 void buble_sort_cfg_exception(jd_method *m, list_cmp_fn fn);
 
+void sort_cfg_exception(jd_method *m, list_cmp_fn fn);
+
 #endif //GARLIC_EXCEPTION_H
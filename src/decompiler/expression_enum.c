@@ -124,7 +124,8 @@ void optimize_enum_class(jsource_file *jf)
 
     for (int i = 0; i < jf->methods->size; ++i) {
         jd_method *m = lget_obj(jf->methods, i);
-        if (method_is_empty(m) || method_is_unsupport(m))
+        if (method_is_empty(m) || method_is_unsupport(m) ||
+            method_is_truncated(m))
             continue;
         optimize_enum_methods(m);
         optimize_enum_statics(m);
@@ -41,6 +41,28 @@ static bool is_catch_param_v2(jd_method *m, jd_exp *exp)
            parent->start_idx == exp->idx;
 }
 
+static bool exp_uses_local_variable(jd_exp *exp, string name)
+{
+    list_object *list = linit_object();
+    if (exp_is_if(exp)) {
+        jd_exp_if *if_exp = exp->data;
+        visit_expression_for_local_variable(if_exp->expression, list);
+    }
+    else {
+        visit_expression_for_local_variable(exp, list);
+    }
+
+    for (int i = 0; i < list->size; ++i) {
+        jd_exp *e = lget_obj(list, i);
+        if (!exp_is_local_variable(e))
+            continue;
+        jd_val *v = e->data;
+        if (STR_EQL(v->name, name))
+            return true;
+    }
+    return false;
+}
+
 static bool first_store_can_be_declaraction(jd_method *m,
                                             jd_variable_scope *scope)
 {
@@ -272,18 +294,8 @@ static void variables_scope(jd_method *m)
                 jd_exp *e = lget_obj(m->expressions, j);
                 if (exp_is_nopped(e))
                     continue;
-                if (!exp_is_assignment(e) && !exp_is_store(e))
-                    continue;
 
-                if (exp_is_store(e)) {
-                    jd_exp_store *s = e->data;
-                    jd_exp *l = &s->list->args[0];
-                    jd_val *v = l->data;
-                    if (STR_EQL(val->name, v->name)) {
-                        end_idx = e->idx;
-                    }
-                }
-                else {
+                if (exp_is_assignment(e)) {
                     jd_exp_assignment *assign = e->data;
                     jd_exp *r = assign->right;
                     if (!exp_is_local_variable(r))
@@ -293,6 +305,11 @@ static void variables_scope(jd_method *m)
                         end_idx = e->idx;
                     }
                 }
+                else if (exp_uses_local_variable(e, val->name)) {
+                    // later stores and reads, a read after the last
+                    // store still needs the declaration in scope
+                    end_idx = e->idx;
+                }
             }
             range->end_idx = end_idx == 0 ? exp->idx : end_idx;
 
@@ -408,4 +425,19 @@ void variables_rename(jd_method *m)
                         val->data->cname);
         }
     }
+
+    // a store merged away (e.g. one arm of a ternary) may still own the
+    // val the loads after the merge point to, give it the kept name
+    for (int i = 0; i < m->expressions->size; ++i) {
+        jd_exp *exp = lget_obj(m->expressions, i);
+        if (!exp_is_nopped(exp) || !exp_is_store(exp))
+            continue;
+        jd_exp_store *store = exp->data;
+        jd_val *val = store->list->args[0].data;
+        if (val->name_type == JD_VAR_NAME_DEBUG)
+            continue;
+        string var_name = hget_s2s(m->var_name_map, val->name);
+        if (var_name != NULL)
+            val->name = var_name;
+    }
 }
\ No newline at end of file
@@ -163,9 +163,9 @@ bool identify_initialize(jd_method *m)
             continue;
 
         if (exp_is_assignment(exp))
-            found = identify_initialize_of_assignment(m, exp, i);
+            found |= identify_initialize_of_assignment(m, exp, i);
         else if (exp_is_store(exp))
-            found = identify_initialize_of_store(m, exp, i);
+            found |= identify_initialize_of_store(m, exp, i);
 
     }
     return found;
@@ -24,6 +24,9 @@ static bool ternary_on_basic_block(jd_method *m, jd_bblock *block)
     if (jvm_ins_is_goto_back(ins))
         return result;
 
+    // the condition was negated by negative_if_expression, it holds
+    // for the fall through side: true_exp (the jump target) is the
+    // false value of the ternary and false_exp the true value
     jd_exp_if *if_exp = exp->data;
     jd_exp *true_exp = exp_of_offset(m, if_exp->offset);
 //    jd_exp *false_exp = ins->next->expression;
@@ -106,8 +109,8 @@ static bool ternary_on_basic_block(jd_method *m, jd_bblock *block)
         condition->data = if_exp->expression->data;
         condition->ins  = if_exp->expression->ins;
 
-        memcpy(ternary_true_val_exp, true_val_exp, sizeof(jd_exp));
-        memcpy(ternary_false_val_exp, false_val_exp, sizeof(jd_exp));
+        memcpy(ternary_true_val_exp, false_val_exp, sizeof(jd_exp));
+        memcpy(ternary_false_val_exp, true_val_exp, sizeof(jd_exp));
 
         jd_exp *out_expression = make_obj(jd_exp);
         out_expression->type = JD_EXPRESSION_TERNARY;
@@ -144,8 +147,8 @@ static bool ternary_on_basic_block(jd_method *m, jd_bblock *block)
         jd_exp *ternary_true_val_exp = &ternary_exp->list->args[1];
         jd_exp *ternary_false_val_exp = &ternary_exp->list->args[2];
         memcpy(condition, if_exp->expression, sizeof(jd_exp));
-        memcpy(ternary_true_val_exp, true_save_right, sizeof(jd_exp));
-        memcpy(ternary_false_val_exp, false_save_right, sizeof(jd_exp));
+        memcpy(ternary_true_val_exp, false_save_right, sizeof(jd_exp));
+        memcpy(ternary_false_val_exp, true_save_right, sizeof(jd_exp));
 
         true_save_right->type = JD_EXPRESSION_TERNARY;
         true_save_right->data = ternary_exp;
@@ -168,8 +171,8 @@ static bool ternary_on_basic_block(jd_method *m, jd_bblock *block)
         jd_exp *ternary_false_val_exp = &ternary_exp->list->args[2];
 
         memcpy(condition, if_exp->expression, sizeof(jd_exp));
-        memcpy(ternary_true_val_exp, true_val_exp, sizeof(jd_exp));
-        memcpy(ternary_false_val_exp, false_val_exp, sizeof(jd_exp));
+        memcpy(ternary_true_val_exp, false_val_exp, sizeof(jd_exp));
+        memcpy(ternary_false_val_exp, true_val_exp, sizeof(jd_exp));
 
         jd_exp_assignment *assignment = make_obj(jd_exp_assignment);
         assignment->left = make_obj(jd_exp);
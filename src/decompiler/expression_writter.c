@@ -30,16 +30,16 @@ static inline string front_ins_string(jd_exp *expression, jd_ins *ins)
 
 }
 
-static inline void front_ins_stream(jsource_file *jf, jd_exp *exp, jd_ins *ins)
+static inline void front_ins_emit(jd_emitter *stream, jd_exp *exp,
+                                  jd_ins *ins)
 {
-    FILE *stream = file_output(jf);
     if (ins == NULL)
-        fprintf(stream, "[%24d] ", exp->idx);
+        emit_printf(stream, "[%24d] ", exp->idx);
     else
-        fprintf(stream, "[%4d %20s %4d] ",
-                ins->offset,
-                ins->name,
-                exp->idx);
+        emit_printf(stream, "[%4d %20s %4d] ",
+                    ins->offset,
+                    ins->name,
+                    exp->idx);
 }
 
 void print_expression(jd_exp *expression, jd_ins *ins)
@@ -114,22 +114,21 @@ void print_exp_full(jd_exp *expression, jd_ins *ins)
                 exp_to_s(expression));
 }
 
-static void write_expression(jsource_file *jf,
+static void write_expression(jd_emitter *stream,
                              jd_node *node,
                              jd_exp *exp,
                              jd_ins *ins,
                              bool terminated)
 {
-    FILE *stream = file_output(jf);
     if (DEBUG_INS_AND_NODE_INFO) {
         if (DEBUG_WRITE_COLOR) {
-            fprintf(stream, "\033[0;31m");
-            front_ins_stream(jf, exp, ins);
-            fprintf(stream, "\033[0m");
+            emit_str(stream, "\033[0;31m");
+            front_ins_emit(stream, exp, ins);
+            emit_str(stream, "\033[0m");
             expression_to_stream(stream, node, exp);
         }
         else {
-            front_ins_stream(jf, exp, ins);
+            front_ins_emit(stream, exp, ins);
             expression_to_stream(stream, node, exp);
         }
     }
@@ -137,7 +136,7 @@ static void write_expression(jsource_file *jf,
         expression_to_stream(stream, node, exp);
     }
     if (terminated)
-        fprintf(stream, ";\n");
+        emit_str(stream, ";\n");
 }
 
 void print_all_expression(jd_method *m)
@@ -369,23 +368,15 @@ string lambada_method_ident(jd_method *m)
 // for lambda m?
 string method_block_to_string(jd_method *m, jd_node *node)
 {
-    string buf = NULL;
-    FILE *stream;
-    size_t len = 0;
-
-#ifdef _WIN32
-    // Windows doesn't have open_memstream, use tmpfile as alternative
-    stream = tmpfile();
-#else
-    stream = open_memstream(&buf, &len);
-#endif
+    jd_emitter e;
+    jd_emitter *stream = &e;
+    emitter_init(stream, NULL);
 
     if (node == NULL)
         node = lget_obj_first(m->nodes);
 
     for (int i = 0; i < node->children->size; ++i) {
         jd_node *child = lget_obj(node->children, i);
-        string ident = get_node_ident(child);
         if (child->type == JD_NODE_EXPRESSION) {
             jd_exp *exp = child->data;
             if (exp_is_nopped(exp) ||
@@ -394,12 +385,16 @@ string method_block_to_string(jd_method *m, jd_node *node)
                 exp_is_switch(exp))
                 continue;
 
-
-            fprintf(stream, "%s%s%s;\n",
-                    ident,
-                    front_ins_string(exp, exp->ins),
-                    exp_to_s(exp));
-            fflush(stream);
+            emit_ident(stream, child);
+            if (exp->ins == NULL)
+                emit_printf(stream, "[%24d] ", exp->idx);
+            else
+                emit_printf(stream, "[%4d %23s %4d] ",
+                            exp->ins->offset,
+                            exp->ins->name,
+                            exp->idx);
+            expression_to_stream(stream, child, exp);
+            emit_str(stream, ";\n");
         }
         else {
             if (child->type == JD_NODE_IF ||
@@ -407,124 +402,114 @@ string method_block_to_string(jd_method *m, jd_node *node)
                 child->type == JD_NODE_ELSE_IF) {
                 jd_node *first = node_first_effective_child(child);
                 jd_exp *expression = first->data;
-                fprintf(stream,
-                        "%s%s (%s) { "
-                        "// block_id: %d  "
-                        "range: %d - %d  "
-                        "parent_id: %d\n",
-                        ident,
-                        node_name(child),
-                        exp_to_s(expression),
-                        first->node_id,
-                        first->start_idx,
-                        first->end_idx,
-                        first->parent->node_id);
+                emit_ident(stream, child);
+                emit_printf(stream, "%s (", node_name(child));
+                expression_to_stream(stream, child, expression);
+                emit_printf(stream,
+                            ") { "
+                            "// block_id: %d  "
+                            "range: %d - %d  "
+                            "parent_id: %d\n",
+                            first->node_id,
+                            first->start_idx,
+                            first->end_idx,
+                            first->parent->node_id);
             }
             else {
-                fprintf(stream, 
-                        "%s%s { "
-                        "// block_id: %d  "
-                        "range: %d - %d  "
-                        "parent_id: %d\n",
-                        ident,
-                        node_name(child),
-                        child->node_id,
-                        child->start_idx,
-                        child->end_idx,
-                        child->parent->node_id);
+                emit_ident(stream, child);
+                emit_printf(stream,
+                            "%s { "
+                            "// block_id: %d  "
+                            "range: %d - %d  "
+                            "parent_id: %d\n",
+                            node_name(child),
+                            child->node_id,
+                            child->start_idx,
+                            child->end_idx,
+                            child->parent->node_id);
             }
-            fprintf(stream, "%s", method_block_to_string(m, child));
-            fprintf(stream, "%s}\n", ident);
-            fflush(stream);
+            emit_str(stream, method_block_to_string(m, child));
+            emit_ident(stream, child);
+            emit_str(stream, "}\n");
         }
     }
-#ifdef _WIN32
-    // For Windows tmpfile approach, we need to read back the content
-    fseek(stream, 0, SEEK_END);
-    len = ftell(stream);
-    fseek(stream, 0, SEEK_SET);
-    
-    string result = x_alloc(len + 1);
-    fread(result, 1, len, stream);
-    result[len] = '\0';
-    fclose(stream);
+    string result = emitter_to_string(stream);
+    emitter_free(stream);
     return result;
-#else
-    string result = x_alloc(len+1);
-    memcpy(result, buf, len+1);
-    result[len] = '\0';
-    free(buf);
-    fclose(stream);
-    return result;
-#endif
 }
 
-static void write_notice(jsource_file *jf)
+static void write_notice(jd_emitter *stream)
 {
     if (!SOURCE_FILE_NOTICE) return;
-    FILE *stream = file_output(jf);
 
-    fprintf(stream, "/*\n");
-    fprintf(stream, " * Decompiled by Garlic\n");
-    fprintf(stream, " * Version: 1.5\n");
-    fprintf(stream, " */ \n");
+    emit_str(stream, "/*\n");
+    emit_str(stream, " * Decompiled by Garlic\n");
+    emit_str(stream, " * Version: 1.5\n");
+    emit_str(stream, " */ \n");
+}
+
+static void write_import_leaf(jd_emitter *stream, jd_trie_node *node)
+{
+    if (node == NULL)
+        return;
+    if (node->is_leaf) {
+        emit_str(stream, "import ");
+        for (string c = node->full; *c; ++c)
+            emit_char(stream, *c == '/' ? '.' : *c);
+        emit_str(stream, ";\n");
+    }
+
+    if (node->child != NULL)
+        write_import_leaf(stream, node->child);
+    if (node->next != NULL)
+        write_import_leaf(stream, node->next);
 }
 
-static void write_import(jsource_file *jf)
+static void write_import(jd_emitter *stream, jsource_file *jf)
 {
-    FILE *stream = file_output(jf);
     if (jf->pname != NULL) {
-        fprintf(stream, "package ");
-        for (int i = 0; i < strlen(jf->pname); ++i) {
-            unsigned char c = jf->pname[i];
-            if (c == '/')
-                fprintf(stream, ".");
-            else
-                fprintf(stream, "%c", c);
-        }
-        fprintf(stream, ";\n\n");
+        emit_str(stream, "package ");
+        for (string c = jf->pname; *c; ++c)
+            emit_char(stream, *c == '/' ? '.' : *c);
+        emit_str(stream, ";\n\n");
     }
 
-    trie_leaf_to_stream(jf->imports, stream);
-    fprintf(stream, "\n");
+    write_import_leaf(stream, jf->imports);
+    emit_char(stream, '\n');
 }
 
-static void write_class_annotation(jsource_file *jf)
+static void write_class_annotation(jd_emitter *stream, jsource_file *jf)
 {
-    FILE *stream = file_output(jf);
     for (int i = 0; i < jf->annotations->size; ++i) {
         jd_annotation *ano = lget_obj(jf->annotations, i);
         for (int j = 0; j < strlen(ano->str); ++j) {
             unsigned char c = ano->str[j];
             if (iscntrl(c)) {
-                fprintf(stream, "\\%02X", c);
+                emit_printf(stream, "\\%02X", c);
             }
             else {
-                fprintf(stream, "%c", c);
+                emit_char(stream, c);
             }
         }
-        fprintf(stream, "\n");
+        emit_char(stream, '\n');
     }
 }
 
-static void write_method_annotation(jsource_file *jf, jd_node *node)
+static void write_method_annotation(jd_emitter *stream, jd_node *node)
 {
-    string ident = get_node_ident(node);
     jd_method *m = node->data;
     if (method_is_lambda(m))
         return;
 
-    FILE *stream = file_output(jf);
     for (int j = 0; j < m->annotations->size; ++j) {
         jd_annotation *ano = lget_obj(m->annotations, j);
-        fprintf(stream, "%s%s\n", ident, ano->str);
+        emit_ident(stream, node);
+        emit_printf(stream, "%s\n", ano->str);
     }
 }
 
-static void write_field(jsource_file *jf, jd_node *node)
+static void write_field(jd_emitter *stream, jsource_file *jf, jd_node *node)
 {
-    string ident = get_node_ident(node);
-    FILE *stream = file_output(jf);
     for (int i = 0; i < jf->fields_count; ++i) {
         jd_field *field = &jf->fields[i];
         if (field_is_hide(field) || field_is_assert(field))
@@ -534,251 +519,346 @@ static void write_field(jsource_file *jf, jd_node *node)
         for (int j = 0; j < field->annotations->size; ++j) {
             jd_annotation *ano = lget_obj(field->annotations, j);
             string annotation = ano->str;
-            fprintf(stream, "%s%s\n", ident, annotation);
+            emit_ident(stream, node);
+            emit_printf(stream, "%s\n", annotation);
         }
-        fprintf(stream, "%s%s;\n", ident, field->defination);
+        emit_ident(stream, node);
+        emit_printf(stream, "%s;\n", field->defination);
     }
-    fprintf(stream, "\n");
+    emit_char(stream, '\n');
 }
 
-static void write_node_debug_info(jsource_file *jf, jd_node *node)
+static void write_node_debug_info(jd_emitter *stream, jd_node *node)
 {
     if (DEBUG_INS_AND_NODE_INFO) {
         if (DEBUG_WRITE_COLOR) {
             printf("\033[0;32m");
-            fprintf(file_output(jf), " // node_id: %d  "
-                                       "range: %d - %d  "
-                                       "parent_id: %d",
-                    node->node_id,
-                    node->start_idx,
-                    node->end_idx,
-                    node->parent->node_id);
+            emit_printf(stream, " // node_id: %d  "
+                                "range: %d - %d  "
+                                "parent_id: %d",
+                        node->node_id,
+                        node->start_idx,
+                        node->end_idx,
+                        node->parent->node_id);
             printf("\033[0m");
         } else {
-            fprintf(file_output(jf), " // block_id: %d  "
-                                       "range: %d - %d  "
-                                       "parent_id: %d",
-                    node->node_id,
-                    node->start_idx,
-                    node->end_idx,
-                    node->parent->node_id);
+            emit_printf(stream, " // block_id: %d  "
+                                "range: %d - %d  "
+                                "parent_id: %d",
+                        node->node_id,
+                        node->start_idx,
+                        node->end_idx,
+                        node->parent->node_id);
         }
     }
-    fprintf(file_output(jf), "\n");
+    emit_char(stream, '\n');
 }
 
-static void write_class(FILE *stream, jd_node *n)
+static void write_class(jd_emitter *stream, jd_node *n)
 {
-    string ident = get_node_ident(n);
     jsource_file *_source_file = n->data;
-    fprintf(stream, "%s// class: %s\n", ident, _source_file->fname);
-    write_class_annotation(_source_file);
-    fprintf(stream, "%s%s {\n", ident, _source_file->defination);
-    writter_for_class(_source_file, n);
-    fprintf(stream, "%s}\n", ident);
+    emit_ident(stream, n);
+    emit_printf(stream, "// class: %s\n", _source_file->fname);
+    write_class_annotation(stream, _source_file);
+    emit_ident(stream, n);
+    emit_printf(stream, "%s {\n", _source_file->defination);
+    writter_for_class_nodes(stream, _source_file, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
 }
 
-static void write_anonymous_class(FILE *stream, jsource_file *jf, jd_node *n)
+static void write_anonymous_class(jd_emitter *stream, jd_node *n)
 {
-    string ident = get_node_ident(n);
     jsource_file *_source_file = n->data;
-    write_class_annotation(_source_file);
-    fprintf(stream, "%s%s {\n", ident, _source_file->defination);
-    writter_for_anonymous_class(_source_file, n);
-    fprintf(stream, "%s}\n", ident);
+    write_class_annotation(stream, _source_file);
+    emit_ident(stream, n);
+    emit_printf(stream, "%s {\n", _source_file->defination);
+    writter_for_anonymous_class(stream, _source_file, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
 }
 
-static void write_method(FILE *stream, jsource_file *jf, jd_node *node)
+static void write_truncated_bytecode(jd_emitter *stream, jd_node *node,
+                                     jd_method *m)
+{
+    if (m->fn->bytecode_fn == NULL)
+        return;
+
+    string buf = NULL;
+    size_t len = 0;
+    // without a stream the body keeps the comments only
+#ifdef _WIN32
+    FILE *code = tmpfile();
+    if (code == NULL)
+        return;
+    m->fn->bytecode_fn(m, code);
+    long end = ftell(code);
+    if (end > 0 && fseek(code, 0, SEEK_SET) == 0) {
+        buf = x_alloc(end + 1);
+        len = fread(buf, 1, end, code);
+    }
+#else
+    FILE *code = open_memstream(&buf, &len);
+    if (code == NULL)
+        return;
+    m->fn->bytecode_fn(m, code);
+    fflush(code);
+#endif
+
+    string line = buf;
+    while (line < buf + len) {
+        string end = memchr(line, '\n', buf + len - line);
+        int size = end != NULL ? (int)(end - line) : (int)(buf + len - line);
+        emit_ident(stream, node);
+        emit_str(stream, "    // ");
+        emit_bytes(stream, line, size);
+        emit_char(stream, '\n');
+        line += size + 1;
+    }
+    fclose(code);
+#ifndef _WIN32
+    free(buf);
+#endif
+}
+
+/**
+ * a method over its budget keeps its defination, the body is the
+ * javap/smali listing of its bytecode commented out, followed by a
+ * throw so the source still compiles when the method returns a value.
+ * a static initializer must complete normally, it keeps the comments only
+ **/
+static void write_truncated_method(jd_emitter *stream, jd_node *node,
+                                   jd_method *m)
+{
+    emit_ident(stream, node);
+    emit_printf(stream, "    // %s\n", m->truncated);
+    emit_ident(stream, node);
+    emit_str(stream, "    // method body left as bytecode\n");
+    write_truncated_bytecode(stream, node, m);
+    if (method_is_clinit(m))
+        return;
+    emit_ident(stream, node);
+    emit_str(stream, "    throw new UnsupportedOperationException("
+                     "\"decompilation truncated\");\n");
+}
+
+static void write_method(jd_emitter *stream, jsource_file *jf, jd_node *node)
 {
-    string ident = get_node_ident(node);
     jd_method *m = node->data;
     if (method_is_lambda(m) || method_is_hide(m))
         return;
 
-    write_method_annotation(jf, node);
+    write_method_annotation(stream, node);
     if (method_is_empty(m)) {
-        fprintf(stream, "%s%s;\n\n", ident,
-                create_method_defination(m));
+        emit_ident(stream, node);
+        emit_printf(stream, "%s;\n\n", create_method_defination(m));
         return;
     }
+    else {
+        emit_ident(stream, node);
+        emit_printf(stream, "%s {\n", create_method_defination(m));
+    }
+    if (method_is_truncated(m))
+        write_truncated_method(stream, node, m);
     else
-        fprintf(stream, "%s%s {\n", ident,
-                create_method_defination(m));
-    writter_for_class(jf, node);
-    fprintf(stream, "%s}\n\n", ident);
+        writter_for_class_nodes(stream, jf, node);
+    emit_ident(stream, node);
+    emit_str(stream, "}\n\n");
 }
 
-static void write_expression_node(FILE *stream, jsource_file *jf, jd_node *n)
+static void write_expression_node(jd_emitter *stream, jd_node *n)
 {
     jd_exp *exp = n->data;
     if (exp_is_nopped(exp) ||
         exp_is_empty(exp))
         return;
-    string ident = get_node_ident(n);
-    fprintf(stream, "%s", ident);
-    write_expression(jf, n, exp, exp->ins, true);
+    emit_ident(stream, n);
+    write_expression(stream, n, exp, exp->ins, true);
 }
 
-static void write_basic_block(FILE *stream, jsource_file *jf, jd_node *n)
+static void write_basic_block(jd_emitter *stream, jd_node *n)
 {
-    string ident = get_node_ident(n);
     for (int j = n->start_idx; j <= n->end_idx; ++j) {
         jd_exp *exp = get_exp(n->method, j);
         if (exp_is_nopped(exp) ||
             exp_is_empty(exp))
             continue;
-        fprintf(stream, "%s", ident);
-        write_expression(jf, n, exp, exp->ins, true);
+        emit_ident(stream, n);
+        write_expression(stream, n, exp, exp->ins, true);
     }
 }
 
-static void write_if_node(FILE *stream, jsource_file *jf, jd_node *n)
+static void write_if_node(jd_emitter *stream, jsource_file *jf, jd_node *n)
 {
     if (n->children->size == 0)
         return;
-    string ident = get_node_ident(n);
-    fprintf(stream, "%s", ident);
-    fprintf(stream, "%s (", node_name(n));
-    write_expression(jf, n, n->param_exp, n->param_exp->ins, false);
-    fprintf(stream, ") {");
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s}\n", ident);
-}
-
-static void write_switch_node(FILE *stream, jsource_file *jf, jd_node *n)
-{
-    string ident = get_node_ident(n);
-    fprintf(stream, "%s%s(", ident, node_name(n));
-    write_expression(jf, n, n->param_exp, n->param_exp->ins, false);
-    fprintf(stream, ") {");
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s}\n", ident);
-}
-
-static void write_for_loop_node(FILE *stream, jsource_file *jf, jd_node *n)
-{
-    string ident = get_node_ident(n);
-    fprintf(stream, "%s%s (", ident, node_name(n));
-    write_expression(jf, n, n->param_exp, n->param_exp->ins, false);
-    fprintf(stream, ") {");
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s}\n", ident);
-}
-
-static void write_while_node(FILE *stream, jsource_file *jf, jd_node *n)
-{
-    string ident = get_node_ident(n);
-    fprintf(stream, "%s%s (", ident, node_name(n));
-    write_expression(jf, n, n->param_exp, n->param_exp->ins, false);
-    fprintf(stream, ") {");
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s}\n", ident);
-}
-
-static void write_do_while_node(FILE *stream, jsource_file *jf, jd_node *n)
-{
-    string ident = get_node_ident(n);
-    fprintf(stream, "%sdo {", ident);
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s} while(", ident);
-    write_expression(jf, n, n->param_exp, n->param_exp->ins, false);
-    fprintf(stream, ");\n");
-}
-
-static void write_loop_node(FILE *stream, jsource_file *jf, jd_node *n)
-{
-    string ident = get_node_ident(n);
-    fprintf(stream, "%swhile (true) {", ident);
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s}\n", ident);
-}
-
-static void write_catch(FILE *stream, jsource_file *jf, jd_node *n)
-{
-    string ident = get_node_ident(n);
-    fprintf(stream, "%s%s (", ident, node_name(n));
+    emit_ident(stream, n);
+    emit_printf(stream, "%s (", node_name(n));
+    write_expression(stream, n, n->param_exp, n->param_exp->ins, false);
+    emit_str(stream, ") {");
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
+}
+
+static void write_switch_node(jd_emitter *stream, jsource_file *jf,
+                              jd_node *n)
+{
+    emit_ident(stream, n);
+    emit_printf(stream, "%s(", node_name(n));
+    write_expression(stream, n, n->param_exp, n->param_exp->ins, false);
+    emit_str(stream, ") {");
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
+}
+
+static void write_for_loop_node(jd_emitter *stream, jsource_file *jf,
+                                jd_node *n)
+{
+    emit_ident(stream, n);
+    emit_printf(stream, "%s (", node_name(n));
+    write_expression(stream, n, n->param_exp, n->param_exp->ins, false);
+    emit_str(stream, ") {");
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
+}
+
+static void write_while_node(jd_emitter *stream, jsource_file *jf,
+                             jd_node *n)
+{
+    emit_ident(stream, n);
+    emit_printf(stream, "%s (", node_name(n));
+    write_expression(stream, n, n->param_exp, n->param_exp->ins, false);
+    emit_str(stream, ") {");
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
+}
+
+static void write_do_while_node(jd_emitter *stream, jsource_file *jf,
+                                jd_node *n)
+{
+    emit_ident(stream, n);
+    emit_str(stream, "do {");
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "} while(");
+    write_expression(stream, n, n->param_exp, n->param_exp->ins, false);
+    emit_str(stream, ");\n");
+}
+
+static void write_loop_node(jd_emitter *stream, jsource_file *jf, jd_node *n)
+{
+    emit_ident(stream, n);
+    emit_str(stream, "while (true) {");
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
+}
+
+static void write_catch(jd_emitter *stream, jsource_file *jf, jd_node *n)
+{
+    emit_ident(stream, n);
+    emit_printf(stream, "%s (", node_name(n));
     jd_exp *param_exp = n->param_exp;
     if (param_exp != NULL) {
         jd_val *val = param_exp->data;
-        fprintf(stream, "%s ", val->data->cname);
-        write_expression(jf, n, n->param_exp, n->param_exp->ins, false);
+        emit_printf(stream, "%s ", val->data->cname);
+        write_expression(stream, n, n->param_exp, n->param_exp->ins, false);
     }
-    fprintf(stream, ") {");
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s}\n", ident);
+    emit_str(stream, ") {");
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
 }
 
-static void write_case(FILE *stream, jsource_file *jf, jd_node *n)
+static void write_case(jd_emitter *stream, jsource_file *jf, jd_node *n)
 {
-    string ident = get_node_ident(n);
     jd_case *_case = n->data;
+    emit_ident(stream, n);
     if (_case->is_default)
-        fprintf(stream, "%sdefault: {", ident);
-    else {
-        fprintf(stream, "%s%s ", ident, node_name(n));
-        fprintf(stream, "%d", _case->key);
-        fprintf(stream, ": {");
-    }
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s}\n", ident);
+        emit_str(stream, "default: {");
+    else
+        emit_printf(stream, "%s %d: {", node_name(n), _case->key);
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
 }
 
-static void write_synchronized(FILE *stream, jsource_file *jf, jd_node *n)
+static void write_synchronized(jd_emitter *stream, jsource_file *jf,
+                               jd_node *n)
 {
-    string ident = get_node_ident(n);
-    fprintf(stream, "%s%s (", ident, node_name(n));
+    emit_ident(stream, n);
+    emit_printf(stream, "%s (", node_name(n));
     if (n->param_exp != NULL)
-        write_expression(jf, n, n->param_exp, n->param_exp->ins, false);
-    fprintf(stream, ") {");
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s}\n", ident);
+        write_expression(stream, n, n->param_exp, n->param_exp->ins, false);
+    emit_str(stream, ") {");
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
 }
 
-static void write_default(FILE *stream, jsource_file *jf, jd_node *n)
+static void write_default(jd_emitter *stream, jsource_file *jf, jd_node *n)
 {
-    string ident = get_node_ident(n);
-    fprintf(stream, "%s", ident);
-    fprintf(stream, "%s {", node_name(n));
-    write_node_debug_info(jf, n);
-    writter_for_class(jf, n);
-    fprintf(stream, "%s}\n", ident);
+    emit_ident(stream, n);
+    emit_printf(stream, "%s {", node_name(n));
+    write_node_debug_info(stream, n);
+    writter_for_class_nodes(stream, jf, n);
+    emit_ident(stream, n);
+    emit_str(stream, "}\n");
 }
 
+/**
+ * the whole source file goes into one emitter, it reaches jf->source
+ * with a single write
+ **/
 void writter_for_class(jsource_file *jf, jd_node *node)
+{
+    jd_emitter e;
+    emitter_init(&e, file_output(jf));
+    writter_for_class_nodes(&e, jf, node);
+    emitter_flush(&e);
+    emitter_free(&e);
+}
+
+void writter_for_class_nodes(jd_emitter *stream,
+                             jsource_file *jf,
+                             jd_node *node)
 {
     if (node == NULL)
         node = lget_obj_first(jf->blocks);
-    FILE *stream = file_output(jf);
     for (int i = 0; i < node->children->size; ++i) {
         jd_node *child = lget_obj(node->children, i);
         switch (child->type) {
             case JD_NODE_PACKAGE_IMPORT:
-                write_notice(jf);
-                write_import(jf);
+                write_notice(stream);
+                write_import(stream, jf);
                 break;
             case JD_NODE_CLASS:
                 write_class(stream, child);
                 break;
             case JD_NODE_FIELD:
-                write_field(jf, child);
+                write_field(stream, jf, child);
                 break;
             case JD_NODE_METHOD:
                 write_method(stream, jf, child);
                 break;
             case JD_NODE_EXPRESSION:
-                write_expression_node(stream, jf, child);
+                write_expression_node(stream, child);
                 break;
             case JD_NODE_BASIC_BLOCK:
-                write_basic_block(stream, jf, child);
+                write_basic_block(stream, child);
                 break;
             case JD_NODE_DELETED:
                 break;
@@ -817,28 +897,29 @@ void writter_for_class(jsource_file *jf, jd_node *node)
     }
 }
 
-void writter_for_anonymous_class(jsource_file *jf, jd_node *node)
+void writter_for_anonymous_class(jd_emitter *stream,
+                                 jsource_file *jf,
+                                 jd_node *node)
 {
     if (node == NULL)
         node = lget_obj_first(jf->blocks);
-    FILE *stream = file_output(jf);
     for (int i = 0; i < node->children->size; ++i) {
         jd_node *child = lget_obj(node->children, i);
         switch (child->type) {
             case JD_NODE_CLASS:
-                write_anonymous_class(stream, jf, child);
+                write_anonymous_class(stream, child);
                 break;
             case JD_NODE_FIELD:
-                write_field(jf, child);
+                write_field(stream, jf, child);
                 break;
             case JD_NODE_METHOD:
                 write_method(stream, jf, child);
                 break;
             case JD_NODE_EXPRESSION:
-                write_expression_node(stream, jf, child);
+                write_expression_node(stream, child);
                 break;
             case JD_NODE_BASIC_BLOCK:
-                write_basic_block(stream, jf, child);
+                write_basic_block(stream, child);
                 break;
             case JD_NODE_DELETED:
                 break;
@@ -2,6 +2,7 @@
 #define GARLIC_EXPRESSION_WRITTER_H
 
 #include "decompiler/structure.h"
+#include "decompiler/emitter.h"
 #include "expression_node_helper.h"
 
 #define DEFAULT_WRITE_OUT stdout
@@ -14,7 +15,13 @@ void jsource_file_writter_first(jsource_file *jf, jd_node *node);
 
 void writter_for_class(jsource_file *jf, jd_node *node);
 
-void writter_for_anonymous_class(jsource_file *jf, jd_node *node);
+void writter_for_class_nodes(jd_emitter *stream,
+                             jsource_file *jf,
+                             jd_node *node);
+
+void writter_for_anonymous_class(jd_emitter *stream,
+                                 jsource_file *jf,
+                                 jd_node *node);
 
 string method_block_to_string(jd_method *m, jd_node *node);
 
@@ -28,9 +35,8 @@ void print_all_expression_with_ssa(jd_method *m);
 
 void print_full_expression(jd_method *m);
 
-static inline string get_node_ident(jd_node *node)
+static inline int node_ident_level(jd_node *node)
 {
-    int tabsize = 4;
     int level = 0;
     jd_node *parent = node->parent;
     while (parent != NULL) {
@@ -41,6 +47,13 @@ static inline string get_node_ident(jd_node *node)
 
     if (!node_is_package_import(node))
         level --;
+    return level;
+}
+
+static inline string get_node_ident(jd_node *node)
+{
+    int tabsize = 4;
+    int level = node_ident_level(node);
 
     string ident = NULL;
     if (level > 0) {
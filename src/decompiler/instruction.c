@@ -1 +1,29 @@
 #include "decompiler/instruction.h"
+
+void ins_offset_index_sync(jd_method *m)
+{
+    list_object *instructions = m->instructions;
+    uint32_t max_offset = 0;
+    for (int i = m->offset2ins_synced; i < instructions->size; ++i) {
+        // jd_dex_ins starts with the same fields as jd_ins
+        jd_ins *ins = lget_obj(instructions, i);
+        if (ins->offset > max_offset)
+            max_offset = ins->offset;
+    }
+
+    if (max_offset >= m->offset2ins_size) {
+        uint32_t size = m->offset2ins_size == 0 ? 64 : m->offset2ins_size;
+        while (size <= max_offset)
+            size *= 2;
+        m->offset2ins = x_realloc(m->offset2ins,
+                                  sizeof(void*) * m->offset2ins_size,
+                                  sizeof(void*) * size);
+        m->offset2ins_size = size;
+    }
+
+    for (int i = m->offset2ins_synced; i < instructions->size; ++i) {
+        jd_ins *ins = lget_obj(instructions, i);
+        m->offset2ins[ins->offset] = ins;
+    }
+    m->offset2ins_synced = instructions->size;
+}
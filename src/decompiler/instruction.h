@@ -26,10 +26,32 @@ static inline jd_exp* get_exp(jd_method *m, uint32_t id)
     return lget_obj(m->expressions, id);
 }
 
+void ins_offset_index_sync(jd_method *m);
+
+/**
+ * instructions are only appended, each with a new offset, so the dense
+ * array is extended rather than rebuilt. NULL when no instruction starts
+ * at offset
+ **/
+static inline void* ins_ptr_of_offset(jd_method *m, uint32_t offset)
+{
+    if (m->offset2ins_synced != m->instructions->size)
+        ins_offset_index_sync(m);
+    if (offset < m->offset2ins_size)
+        return m->offset2ins[offset];
+    return NULL;
+}
+
+// -1 when no instruction starts at offset
+static inline int ins_idx_of_offset(jd_method *m, uint32_t offset)
+{
+    jd_ins *ins = ins_ptr_of_offset(m, offset);
+    return ins == NULL ? -1 : ins->idx;
+}
+
 static inline jd_ins* ins_of_offset(jd_method *m, uint32_t offset)
 {
-    int idx = hget_i2i(m->offset2id_map, offset);
-    return get_ins(m, idx);
+    return ins_ptr_of_offset(m, offset);
 }
 
 #define INSTRUCTION_STATE_TOOL(name, flag)          \
@@ -3,6 +3,7 @@
 #include "decompiler/method.h"
 #include "decompiler/expression_node.h"
 #include "common/str_tools.h"
+#include "decompiler/method_tasks.h"
 
 #include "libs/str/str.h"
 
@@ -67,14 +68,14 @@ bool is_anonymous_class(string class_name)
 
 static string class_type_array_name(string class_name, int depth)
 {
+    char buf[256];
     size_t len = strlen(class_name);
-    size_t new_len = len + depth*2 + 1;
-    string new_class_name = x_alloc(new_len);
-    memcpy(new_class_name, class_name, strlen(class_name));
+    size_t new_len = len + depth*2;
+    char *name = new_len < sizeof(buf) ? buf : x_alloc(new_len + 1);
+    memcpy(name, class_name, len);
     for (int i = 0; i < depth; ++i)
-        strcat(new_class_name, "[]");
-    new_class_name[new_len - 1] = '\0';
-    return new_class_name;
+        memcpy(name + len + i*2, "[]", 2);
+    return str_intern_n(name, new_len);
 }
 
 string class_path_to_short(string class_name)
@@ -82,15 +83,26 @@ string class_path_to_short(string class_name)
     const char *last_slash = strrchr(class_name, '/');
     const char *start = (last_slash == NULL) ? class_name : last_slash + 1;
 
-    const char *last_char = strstr(start, ";");
+    const char *last_char = strchr(start, ';');
     size_t len = (last_char != NULL) ? (last_char - start) : strlen(start);
+    return str_intern_n(start, len);
+}
 
-    if (len == 0)
-        return str_dup("");
-    string simple_name = x_alloc(len + 1);
-    strncpy(simple_name, start, len);
-    simple_name[len] = '\0';
-    return simple_name;
+/**
+ * the first n bytes of name without the generic part after the last '<'
+ * and the trailing ';'
+ **/
+static string class_name_slice(const char *name, size_t n)
+{
+    for (size_t i = n; i-- > 1;) {
+        if (name[i] == '<') {
+            n = i;
+            break;
+        }
+    }
+    if (n > 0 && name[n - 1] == ';')
+        n--;
+    return str_intern_n(name, n);
 }
 
 void cut_generic_type_from_class_name(string class_name)
@@ -128,16 +140,9 @@ string class_full_name(string descriptor)
                 c = descriptor[depth];
             }
             switch (c) {
-                case 'L': {
-                    size_t class_name_len = len - depth - 1 + 1;
-                    string class_name = x_alloc(class_name_len);
-                    memcpy(class_name, descriptor + depth + 1, class_name_len);
-                    cut_generic_type_from_class_name(class_name);
-                    size_t _tmp_len = strlen(class_name);
-                    if (class_name[_tmp_len-1] == ';')
-                        class_name[_tmp_len-1] = '\0';
-                    return class_name;
-                }
+                case 'L':
+                    return class_name_slice(descriptor + depth + 1,
+                                            len - depth - 1);
                 case 'I': return class_type_array_name((string)g_str_int, depth);
                 case 'J': return class_type_array_name((string)g_str_long, depth);
                 case 'F': return class_type_array_name((string)g_str_float, depth);
@@ -150,16 +155,8 @@ string class_full_name(string descriptor)
                     return NULL;
             }
         }
-        case 'L': {
-            string class_name = x_alloc(len);
-            memcpy(class_name, descriptor + 1, len - 1);
-            class_name[len - 1] = '\0';
-            cut_generic_type_from_class_name(class_name);
-            size_t _tmp_len = strlen(class_name);
-            if (class_name[_tmp_len-1] == ';')
-                class_name[_tmp_len-1] = '\0';
-            return class_name;
-        }
+        case 'L':
+            return class_name_slice(descriptor + 1, len - 1);
         default:
             return descriptor;
     }
@@ -247,11 +244,8 @@ string class_package_name_of(string path)
     if (start == 0)
         return NULL;
 
-    string package = x_alloc(start+1);
-    memcpy(package, path, start);
-    package[start] = '\0';
     // str_replace_char(package, '/', '.');
-    return package;
+    return str_intern_n(path, start);
 }
 
 string class_package_name(jsource_file *jf)
@@ -291,6 +285,9 @@ void class_import(jsource_file *jf, string path)
         path[0] == '[')
         return;
 
+    if (method_tasks_defer_import(jf, path))
+        return;
+
     if (trie_search(jf->imports, path))
         return;
     trie_insert(jf->imports, path);
@@ -491,7 +488,7 @@ void class_create_blocks(jsource_file *jf)
 
         if (method_is_empty(m) /*|| method_is_synthetic(m)*/)
             continue;
-        if (method_is_unsupport(m)) {
+        if (method_is_unsupport(m) || method_is_truncated(m)) {
             class_build_unsupport_method(m);
         }
         jd_node *method_root_block = lget_obj(m->nodes, 0);
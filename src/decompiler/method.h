@@ -93,6 +93,16 @@ static inline bool method_is_unsupport(jd_method *m)
     return access_flags_contains(m->state_flag, METHOD_STATE_UNSUPPORT);
 }
 
+static inline void method_mark_truncated(jd_method *m)
+{
+    m->state_flag |= METHOD_STATE_TRUNCATED;
+}
+
+static inline bool method_is_truncated(jd_method *m)
+{
+    return access_flags_contains(m->state_flag, METHOD_STATE_TRUNCATED);
+}
+
 static inline bool method_is_lambda(jd_method *m)
 {
     return access_flags_contains(m->state_flag, METHOD_STATE_LAMBDA);
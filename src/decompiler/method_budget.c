@@ -0,0 +1,70 @@
+#include <time.h>
+
+#include "common/debug.h"
+#include "common/str_tools.h"
+#include "decompiler/method_budget.h"
+#include "decompiler/method.h"
+
+jd_method_budget g_method_budget = {0, 0, 0, 0};
+
+static inline u8 budget_now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u8)ts.tv_sec * 1000000000ull + (u8)ts.tv_nsec;
+}
+
+static bool budget_truncate(jd_method *m, string reason)
+{
+    method_mark_truncated(m);
+    m->truncated = reason;
+    DEBUG_PRINT("[budget] %s truncated: %s\n", m->name, reason);
+    return true;
+}
+
+void method_budget_begin(jd_method *m)
+{
+    if (g_method_budget.ms > 0)
+        m->budget_start_ns = budget_now_ns();
+}
+
+bool method_budget_exceeded(jd_method *m)
+{
+    if (method_is_truncated(m))
+        return true;
+
+    jd_method_budget *budget = &g_method_budget;
+    if (budget->instructions > 0 && m->instructions != NULL &&
+        m->instructions->size > budget->instructions)
+        return budget_truncate(m, str_create(
+                "%d instructions over the budget of %u",
+                m->instructions->size,
+                budget->instructions));
+
+    if (budget->blocks > 0 && m->basic_blocks != NULL &&
+        m->basic_blocks->size > budget->blocks)
+        return budget_truncate(m, str_create(
+                "%d basic blocks over the budget of %u",
+                m->basic_blocks->size,
+                budget->blocks));
+
+    if (budget->ms > 0) {
+        u8 ms = (budget_now_ns() - m->budget_start_ns) / 1000000;
+        if (ms > budget->ms)
+            return budget_truncate(m, str_create(
+                    "%llu ms over the budget of %u ms",
+                    (unsigned long long)ms,
+                    budget->ms));
+    }
+    return false;
+}
+
+bool method_budget_rounds_exceeded(jd_method *m, int rounds)
+{
+    jd_method_budget *budget = &g_method_budget;
+    if (budget->iterations > 0 && rounds >= budget->iterations)
+        return budget_truncate(m, str_create(
+                "optimize did not settle within %u iterations",
+                budget->iterations));
+    return method_budget_exceeded(m);
+}
@@ -0,0 +1,29 @@
+#ifndef GARLIC_METHOD_BUDGET_H
+#define GARLIC_METHOD_BUDGET_H
+
+#include "decompiler/structure.h"
+
+/**
+ * per method limits of --max-ins, --max-blocks, --max-iterations and
+ * --max-ms, 0 means unlimited.
+ *
+ * the limits are checked between passes, a method over one of them is
+ * marked truncated and the rest of its passes are skipped. the writer
+ * prints such a method with an empty body and its bytecode as comments
+ **/
+typedef struct {
+    uint32_t    instructions;
+    uint32_t    blocks;
+    uint32_t    iterations;
+    uint32_t    ms;
+} jd_method_budget;
+
+extern jd_method_budget g_method_budget;
+
+void method_budget_begin(jd_method *m);
+
+bool method_budget_exceeded(jd_method *m);
+
+bool method_budget_rounds_exceeded(jd_method *m, int rounds);
+
+#endif //GARLIC_METHOD_BUDGET_H
@@ -0,0 +1,111 @@
+#include "decompiler/method_tasks.h"
+#include "decompiler/klass.h"
+#include "common/str_tools.h"
+#include "libs/threadpool/threadpool.h"
+
+typedef struct jd_method_tasks jd_method_tasks;
+
+typedef struct {
+    jd_method_tasks *group;
+    void            *item;
+    mem_pool        *arena;
+    jd_method       *method;
+    // class_import paths, replayed after the join
+    list_object     *imports;
+} jd_method_task;
+
+struct jd_method_tasks {
+    jsource_file        *jf;
+    jd_method_task_fn   fn;
+    int                 pending;
+    jd_method_task      *tasks;
+    // intern scope of the class task, entered by every method task
+    jd_intern           *intern;
+};
+
+// the method task running on this thread, NULL in a class task
+static __thread jd_method_task *current_task = NULL;
+
+static threadpool_t* method_tasks_pool()
+{
+    thread_local_data *tls = get_thread_local_data();
+    if (tls == NULL || tls->worker == NULL)
+        return NULL;
+    return tls->worker->threadpool;
+}
+
+bool method_tasks_enabled(int size)
+{
+    if (size < METHOD_TASKS_MIN_METHODS)
+        return false;
+    threadpool_t *pool = method_tasks_pool();
+    return pool != NULL && pool->thread_count > 1;
+}
+
+static void method_task_run(jd_method_task *task)
+{
+    thread_local_data *tls = get_thread_local_data();
+    mem_pool *pool = tls->pool;
+    jd_method_task *outer = current_task;
+    jd_intern *scope = intern_scope_enter(task->group->intern);
+
+    tls->pool = task->arena;
+    current_task = task;
+    task->method = task->group->fn(task->group->jf, task->item);
+    current_task = outer;
+    tls->pool = pool;
+    intern_scope_leave(scope);
+
+    __atomic_sub_fetch(&task->group->pending, 1, __ATOMIC_RELEASE);
+}
+
+void method_tasks_run(jsource_file *jf,
+                      jd_method_task_fn fn,
+                      void **items,
+                      int size,
+                      list_object *methods)
+{
+    threadpool_t *threadpool = method_tasks_pool();
+    mem_pool *pool = x_current_pool();
+
+    jd_method_tasks *group = make_obj(jd_method_tasks);
+    group->jf = jf;
+    group->fn = fn;
+    group->intern = intern_scope();
+    group->pending = size;
+    group->tasks = make_obj_arr(jd_method_task, size);
+
+    for (int i = 0; i < size; ++i) {
+        jd_method_task *task = &group->tasks[i];
+        task->group = group;
+        task->item = items[i];
+        task->arena = mem_create_pool();
+        mem_pool_adopt(pool, task->arena);
+    }
+
+    // pushed in reverse, the owner takes from the bottom in method order
+    for (int i = size - 1; i >= 0; --i)
+        threadpool_add(threadpool, &method_task_run, &group->tasks[i], 0);
+
+    threadpool_join(threadpool, &method_task_run, &group->pending);
+
+    for (int i = 0; i < size; ++i) {
+        jd_method_task *task = &group->tasks[i];
+        if (task->imports != NULL) {
+            for (int j = 0; j < task->imports->size; ++j)
+                class_import(jf, lget_obj(task->imports, j));
+        }
+        ladd_obj(methods, task->method);
+    }
+}
+
+bool method_tasks_defer_import(jsource_file *jf, string path)
+{
+    jd_method_task *task = current_task;
+    if (task == NULL || task->group->jf != jf)
+        return false;
+    if (task->imports == NULL)
+        task->imports = linit_object();
+    ladd_obj(task->imports, str_dup(path));
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef GARLIC_METHOD_TASKS_H
+#define GARLIC_METHOD_TASKS_H
+
+#include "decompiler/structure.h"
+
+/**
+ * a class with at least this many methods fans its methods out as sub
+ * tasks of the thread pool its class task is running on
+ **/
+#define METHOD_TASKS_MIN_METHODS 64
+
+typedef jd_method* (*jd_method_task_fn)(jsource_file *jf, void *item);
+
+/**
+ * every method is decompiled in its own arena, adopted by the class's
+ * pool so it lives until the class has been written.
+ *
+ * the imports a method adds to jf are kept per method and replayed in
+ * method order after the join, the class ends up exactly as it would
+ * sequentially
+ **/
+bool method_tasks_enabled(int size);
+
+void method_tasks_run(jsource_file *jf,
+                      jd_method_task_fn fn,
+                      void **items,
+                      int size,
+                      list_object *methods);
+
+bool method_tasks_defer_import(jsource_file *jf, string path);
+
+#endif //GARLIC_METHOD_TASKS_H
@@ -0,0 +1,89 @@
+#include "common/debug.h"
+#include "decompiler/pass_manager.h"
+#include "decompiler/profiler.h"
+#include "decompiler/method_budget.h"
+
+typedef struct {
+    int         runs;
+    int         changes;
+    int         skips;
+    // change kinds since the last run, all of them before the first
+    uint32_t    pending;
+} jd_fixpoint_stat;
+
+static bool fixpoint_run(jd_method *m, const jd_fixpoint_pass *pass)
+{
+    if (!g_profile_enabled)
+        return pass->fn(m);
+
+    jd_profile_mark mark;
+    profiler_pass_begin(&mark);
+    bool changed = pass->fn(m);
+    profiler_pass_end(pass->name, &mark);
+    return changed;
+}
+
+/**
+ * a skipped pass must have nothing to find, run it anyway and stop on
+ * the first one whose reads miss a kind of change it depends on
+ **/
+static void fixpoint_check_skip(jd_method *m,
+                                const jd_fixpoint_pass *pass,
+                                uint32_t pending)
+{
+    if (!pass->fn(m))
+        return;
+    fprintf(stderr, "[fixpoint] %s changed %s while skipped, "
+                    "reads: %#x, pending: %#x\n",
+            pass->name, m->name, pass->reads, pending);
+    abort();
+}
+
+void run_fixpoint_passes(jd_method *m,
+                         const jd_fixpoint_pass *passes,
+                         int size)
+{
+    assert(size <= FIXPOINT_MAX_PASSES);
+    jd_fixpoint_stat stats[FIXPOINT_MAX_PASSES];
+    memset(stats, 0, sizeof(stats));
+
+    for (int i = 0; i < size; ++i)
+        stats[i].pending = JD_CHANGE_ALL;
+
+    int rounds = 0;
+    bool dirty = true;
+    while (dirty) {
+        dirty = false;
+        rounds++;
+        for (int i = 0; i < size; ++i) {
+            const jd_fixpoint_pass *pass = &passes[i];
+            jd_fixpoint_stat *stat = &stats[i];
+            if ((stat->pending & pass->reads) == 0) {
+                stat->skips++;
+                if (DEBUG_FIXPOINT)
+                    fixpoint_check_skip(m, pass, stat->pending);
+                continue;
+            }
+            stat->pending = 0;
+            stat->runs++;
+            if (fixpoint_run(m, pass)) {
+                stat->changes++;
+                for (int j = 0; j < size; ++j)
+                    stats[j].pending |= pass->writes;
+                dirty = true;
+            }
+        }
+        if (dirty && method_budget_rounds_exceeded(m, rounds))
+            break;
+    }
+
+    DEBUG_PRINT("[fixpoint] %s rounds: %d\n", m->name, rounds);
+    for (int i = 0; i < size; ++i) {
+        jd_fixpoint_stat *stat = &stats[i];
+        DEBUG_PRINT("[fixpoint] %-40s runs: %d changes: %d skips: %d\n",
+                    passes[i].name,
+                    stat->runs,
+                    stat->changes,
+                    stat->skips);
+    }
+}
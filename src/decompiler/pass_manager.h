@@ -0,0 +1,57 @@
+#ifndef GARLIC_PASS_MANAGER_H
+#define GARLIC_PASS_MANAGER_H
+
+#include "decompiler/structure.h"
+
+/**
+ * the expression passes of the optimize fixpoint loop, each reports
+ * whether it changed the method.
+ *
+ * a pass also declares the kinds of change it makes (writes) and the
+ * kinds of change that can give it something new to find (reads).
+ * every change adds the writes of its pass to the pending kinds of all
+ * passes, and a pass that found nothing is skipped until one of its
+ * reads is pending again. with every kind in reads this is the plain
+ * do { ... } while (changed) loop, the passes still run and change the
+ * method in the same order.
+ * the kinds are kept per method, not per block: most passes follow
+ * next_valid_exp over nopped expressions into other blocks.
+ * build with DEBUG_FIXPOINT to run every skipped pass as well and abort
+ * when one of them still changes the method.
+ * a method over its iteration or time budget leaves the loop after the
+ * round, see method_budget.h
+ **/
+typedef bool (*jd_fixpoint_fn)(jd_method *m);
+
+typedef enum {
+    // an if condition was rewritten or merged into another if
+    JD_CHANGE_CONDITION = 1 << 0,
+    // an if or goto was nopped, blocks were unlinked
+    JD_CHANGE_CONTROL   = 1 << 1,
+    // any other expression was nopped
+    JD_CHANGE_NOP       = 1 << 2,
+    // an expression or one of its operands was rewritten in place
+    JD_CHANGE_VALUE     = 1 << 3,
+    // def, use or dup counts of a stack variable
+    JD_CHANGE_COUNT     = 1 << 4,
+    // m->assignment_chains
+    JD_CHANGE_CHAIN     = 1 << 5,
+    JD_CHANGE_ALL       = (1 << 6) - 1,
+} jd_change_kind;
+
+typedef struct {
+    const char      *name;
+    jd_fixpoint_fn  fn;
+    uint32_t        reads;
+    uint32_t        writes;
+} jd_fixpoint_pass;
+
+#define FIXPOINT_PASS(pass, reads, writes) { #pass, pass, reads, writes }
+
+#define FIXPOINT_MAX_PASSES 32
+
+void run_fixpoint_passes(jd_method *m,
+                         const jd_fixpoint_pass *passes,
+                         int size);
+
+#endif //GARLIC_PASS_MANAGER_H
@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <time.h>
+#include "decompiler/profiler.h"
+#include "decompiler/method.h"
+
+#define PROFILE_MAX_PASSES          64
+#define PROFILE_TOP_METHODS         20
+#define PROFILE_TOP_CLASSES         10
+#define PROFILE_JSON_METHODS        100
+#define PROFILE_JSON_CLASSES        50
+
+typedef struct {
+    const char  *name;
+    u8          ns;
+    u8          bytes;
+    u8          calls;
+} jd_profile_pass;
+
+typedef struct {
+    char        *cname;
+    char        *mname;
+    u8          ns;
+    u8          bytes;
+    const char  *slowest_pass;
+    u8          slowest_ns;
+} jd_profile_method;
+
+typedef struct {
+    const char  *cname;
+    u8          ns;
+    u8          bytes;
+    u8          methods;
+} jd_profile_class;
+
+/**
+ * one per thread, only its owner writes to it, so the counters are
+ * plain adds. the registry lock is taken once per thread
+ **/
+typedef struct jd_profile_thread {
+    jd_profile_pass             passes[PROFILE_MAX_PASSES];
+    int                         passes_size;
+    jd_profile_method           *methods;
+    size_t                      methods_size;
+    size_t                      methods_capacity;
+    const char                  *slowest_pass;
+    u8                          slowest_ns;
+    struct jd_profile_thread    *next;
+} jd_profile_thread;
+
+bool g_profile_enabled = false;
+
+/**
+ * a compiler thread local, not a pthread key: get_thread_local_data
+ * reads its key before creating it on the main thread, a key created
+ * here first would be handed out under that number
+ **/
+static __thread jd_profile_thread   *profile_tls = NULL;
+static pthread_mutex_t              profile_lock = PTHREAD_MUTEX_INITIALIZER;
+static jd_profile_thread            *profile_threads = NULL;
+
+void profiler_enable()
+{
+    g_profile_enabled = true;
+}
+
+static jd_profile_thread* profile_thread()
+{
+    jd_profile_thread *pt = profile_tls;
+    if (pt != NULL)
+        return pt;
+    pt = calloc(1, sizeof(jd_profile_thread));
+    profile_tls = pt;
+    pthread_mutex_lock(&profile_lock);
+    pt->next = profile_threads;
+    profile_threads = pt;
+    pthread_mutex_unlock(&profile_lock);
+    return pt;
+}
+
+static inline u8 profile_now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u8)ts.tv_sec * 1000000000ULL + (u8)ts.tv_nsec;
+}
+
+static void profile_mark(jd_profile_mark *mark)
+{
+    mark->pool = x_current_pool();
+    mark->bytes = mark->pool->alloc_bytes;
+    mark->ns = profile_now_ns();
+}
+
+static void profile_elapsed(jd_profile_mark *mark, u8 *ns, u8 *bytes)
+{
+    *ns = profile_now_ns() - mark->ns;
+    mem_pool *pool = x_current_pool();
+    // the single thread mode swaps the global pool between classes
+    *bytes = pool == mark->pool ? pool->alloc_bytes - mark->bytes : 0;
+}
+
+void profiler_pass_begin(jd_profile_mark *mark)
+{
+    profile_mark(mark);
+}
+
+void profiler_pass_end(const char *pass, jd_profile_mark *mark)
+{
+    u8 ns, bytes;
+    profile_elapsed(mark, &ns, &bytes);
+    jd_profile_thread *pt = profile_thread();
+
+    jd_profile_pass *pp = NULL;
+    for (int i = 0; i < pt->passes_size; ++i) {
+        // the same pass is named by a different literal in each unit
+        if (pt->passes[i].name == pass || STR_EQL(pt->passes[i].name, pass)) {
+            pp = &pt->passes[i];
+            break;
+        }
+    }
+    if (pp == NULL) {
+        if (pt->passes_size == PROFILE_MAX_PASSES)
+            return;
+        pp = &pt->passes[pt->passes_size++];
+        pp->name = pass;
+    }
+    pp->ns += ns;
+    pp->bytes += bytes;
+    pp->calls++;
+
+    if (ns > pt->slowest_ns) {
+        pt->slowest_ns = ns;
+        pt->slowest_pass = pass;
+    }
+}
+
+void profiler_method_begin(jd_profile_mark *mark)
+{
+    jd_profile_thread *pt = profile_thread();
+    mark->slowest_pass = pt->slowest_pass;
+    mark->slowest_ns = pt->slowest_ns;
+    pt->slowest_pass = NULL;
+    pt->slowest_ns = 0;
+    profile_mark(mark);
+}
+
+void profiler_method_end(jd_method *m, jd_profile_mark *mark)
+{
+    u8 ns, bytes;
+    profile_elapsed(mark, &ns, &bytes);
+    jd_profile_thread *pt = profile_thread();
+    const char *slowest_pass = pt->slowest_pass;
+    u8 slowest_ns = pt->slowest_ns;
+    pt->slowest_pass = mark->slowest_pass;
+    pt->slowest_ns = mark->slowest_ns;
+
+    if (method_is_empty(m))
+        return;
+
+    if (pt->methods_size == pt->methods_capacity) {
+        pt->methods_capacity = pt->methods_capacity == 0 ?
+                               256 : pt->methods_capacity * 2;
+        pt->methods = realloc(pt->methods,
+                              sizeof(jd_profile_method) * pt->methods_capacity);
+    }
+    jd_profile_method *pm = &pt->methods[pt->methods_size++];
+    const char *cname = m->jfile != NULL && m->jfile->fname != NULL ?
+                        m->jfile->fname : "?";
+    const char *name = m->name != NULL ? m->name : "?";
+    const char *desc = m->desc != NULL && m->desc->str != NULL ?
+                       m->desc->str : "";
+    // the method's pool is gone by the time of the report
+    pm->cname = strdup(cname);
+    pm->mname = malloc(strlen(name) + strlen(desc) + 1);
+    sprintf(pm->mname, "%s%s", name, desc);
+    pm->ns = ns;
+    pm->bytes = bytes;
+    pm->slowest_pass = slowest_pass;
+    pm->slowest_ns = slowest_ns;
+}
+
+// <editor-fold defaultstate="collapsed" desc="report">
+
+static int cmp_pass_ns(const void *a, const void *b)
+{
+    const jd_profile_pass *x = a, *y = b;
+    return x->ns < y->ns ? 1 : (x->ns > y->ns ? -1 : 0);
+}
+
+static int cmp_method_ns(const void *a, const void *b)
+{
+    const jd_profile_method *x = a, *y = b;
+    return x->ns < y->ns ? 1 : (x->ns > y->ns ? -1 : 0);
+}
+
+static int cmp_method_cname(const void *a, const void *b)
+{
+    const jd_profile_method *x = a, *y = b;
+    return strcmp(x->cname, y->cname);
+}
+
+static int cmp_class_ns(const void *a, const void *b)
+{
+    const jd_profile_class *x = a, *y = b;
+    return x->ns < y->ns ? 1 : (x->ns > y->ns ? -1 : 0);
+}
+
+static void profile_json_string(FILE *fp, const char *s)
+{
+    fputc('"', fp);
+    for (const unsigned char *c = (const unsigned char*)s; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            fprintf(fp, "\\%c", *c);
+        else if (*c < 0x20)
+            fprintf(fp, "\\u%04x", *c);
+        else
+            fputc(*c, fp);
+    }
+    fputc('"', fp);
+}
+
+static void profile_csv_string(FILE *fp, const char *s)
+{
+    fputc('"', fp);
+    for (const char *c = s; *c; c++) {
+        if (*c == '"')
+            fputc('"', fp);
+        fputc(*c, fp);
+    }
+    fputc('"', fp);
+}
+
+static void profile_write_json(const char *path,
+                               jd_profile_pass *passes, int passes_size,
+                               jd_profile_class *classes, size_t classes_size,
+                               jd_profile_method *methods, size_t methods_size)
+{
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "[profile] open %s failed\n", path);
+        return;
+    }
+    fprintf(fp, "{\n  \"passes\": [");
+    for (int i = 0; i < passes_size; ++i) {
+        jd_profile_pass *pp = &passes[i];
+        fprintf(fp, "%s\n    {\"pass\": ", i == 0 ? "" : ",");
+        profile_json_string(fp, pp->name);
+        fprintf(fp, ", \"calls\": %llu, \"ns\": %llu, \"alloc_bytes\": %llu}",
+                (unsigned long long)pp->calls,
+                (unsigned long long)pp->ns,
+                (unsigned long long)pp->bytes);
+    }
+    fprintf(fp, "\n  ],\n  \"classes\": [");
+    size_t n = classes_size < PROFILE_JSON_CLASSES ?
+               classes_size : PROFILE_JSON_CLASSES;
+    for (size_t i = 0; i < n; ++i) {
+        jd_profile_class *pc = &classes[i];
+        fprintf(fp, "%s\n    {\"class\": ", i == 0 ? "" : ",");
+        profile_json_string(fp, pc->cname);
+        fprintf(fp, ", \"methods\": %llu, \"ns\": %llu, \"alloc_bytes\": %llu}",
+                (unsigned long long)pc->methods,
+                (unsigned long long)pc->ns,
+                (unsigned long long)pc->bytes);
+    }
+    fprintf(fp, "\n  ],\n  \"methods\": [");
+    n = methods_size < PROFILE_JSON_METHODS ?
+        methods_size : PROFILE_JSON_METHODS;
+    for (size_t i = 0; i < n; ++i) {
+        jd_profile_method *pm = &methods[i];
+        fprintf(fp, "%s\n    {\"class\": ", i == 0 ? "" : ",");
+        profile_json_string(fp, pm->cname);
+        fprintf(fp, ", \"method\": ");
+        profile_json_string(fp, pm->mname);
+        fprintf(fp, ", \"ns\": %llu, \"alloc_bytes\": %llu, "
+                    "\"slowest_pass\": ",
+                (unsigned long long)pm->ns,
+                (unsigned long long)pm->bytes);
+        profile_json_string(fp, pm->slowest_pass ? pm->slowest_pass : "");
+        fprintf(fp, ", \"slowest_pass_ns\": %llu}",
+                (unsigned long long)pm->slowest_ns);
+    }
+    fprintf(fp, "\n  ]\n}\n");
+    fclose(fp);
+}
+
+static void profile_write_csv(const char *path,
+                              jd_profile_method *methods, size_t methods_size)
+{
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "[profile] open %s failed\n", path);
+        return;
+    }
+    fprintf(fp, "class,method,ns,alloc_bytes,slowest_pass,slowest_pass_ns\n");
+    for (size_t i = 0; i < methods_size; ++i) {
+        jd_profile_method *pm = &methods[i];
+        profile_csv_string(fp, pm->cname);
+        fputc(',', fp);
+        profile_csv_string(fp, pm->mname);
+        fprintf(fp, ",%llu,%llu,%s,%llu\n",
+                (unsigned long long)pm->ns,
+                (unsigned long long)pm->bytes,
+                pm->slowest_pass ? pm->slowest_pass : "",
+                (unsigned long long)pm->slowest_ns);
+    }
+    fclose(fp);
+}
+
+static char* profile_path(const char *out_dir, const char *name)
+{
+    char *path = malloc(strlen(out_dir) + strlen(name) + 2);
+    sprintf(path, "%s/%s", out_dir, name);
+    return path;
+}
+
+/**
+ * called after the thread pool is joined, no thread counts anymore.
+ * the table goes to stderr, stdout may carry the decompiled class
+ **/
+void profiler_report(const char *out_dir)
+{
+    if (!g_profile_enabled)
+        return;
+
+    jd_profile_pass passes[PROFILE_MAX_PASSES];
+    int passes_size = 0;
+    size_t methods_size = 0;
+    for (jd_profile_thread *pt = profile_threads; pt; pt = pt->next) {
+        methods_size += pt->methods_size;
+        for (int i = 0; i < pt->passes_size; ++i) {
+            jd_profile_pass *src = &pt->passes[i];
+            int j = 0;
+            while (j < passes_size && !STR_EQL(passes[j].name, src->name))
+                j++;
+            if (j == passes_size) {
+                if (passes_size == PROFILE_MAX_PASSES)
+                    continue;
+                passes[passes_size++] = *src;
+                continue;
+            }
+            passes[j].ns += src->ns;
+            passes[j].bytes += src->bytes;
+            passes[j].calls += src->calls;
+        }
+    }
+
+    jd_profile_method *methods = malloc(sizeof(jd_profile_method) *
+                                        (methods_size + 1));
+    size_t k = 0;
+    u8 total_ns = 0;
+    u8 total_bytes = 0;
+    for (jd_profile_thread *pt = profile_threads; pt; pt = pt->next) {
+        for (size_t i = 0; i < pt->methods_size; ++i) {
+            methods[k++] = pt->methods[i];
+            total_ns += pt->methods[i].ns;
+            total_bytes += pt->methods[i].bytes;
+        }
+    }
+
+    // classes: group the methods by class name
+    qsort(methods, methods_size, sizeof(jd_profile_method), cmp_method_cname);
+    jd_profile_class *classes = malloc(sizeof(jd_profile_class) *
+                                       (methods_size + 1));
+    size_t classes_size = 0;
+    for (size_t i = 0; i < methods_size; ++i) {
+        jd_profile_method *pm = &methods[i];
+        if (classes_size == 0 ||
+            !STR_EQL(classes[classes_size - 1].cname, pm->cname)) {
+            jd_profile_class *pc = &classes[classes_size++];
+            pc->cname = pm->cname;
+            pc->ns = 0;
+            pc->bytes = 0;
+            pc->methods = 0;
+        }
+        jd_profile_class *pc = &classes[classes_size - 1];
+        pc->ns += pm->ns;
+        pc->bytes += pm->bytes;
+        pc->methods++;
+    }
+
+    qsort(passes, passes_size, sizeof(jd_profile_pass), cmp_pass_ns);
+    qsort(methods, methods_size, sizeof(jd_profile_method), cmp_method_ns);
+    qsort(classes, classes_size, sizeof(jd_profile_class), cmp_class_ns);
+
+    fprintf(stderr, "\n[profile] %zu methods, %zu classes, "
+                    "%.3f ms in methods, %.1f KB allocated\n",
+            methods_size, classes_size,
+            total_ns / 1e6, total_bytes / 1024.0);
+
+    u8 passes_ns = 0;
+    for (int i = 0; i < passes_size; ++i)
+        passes_ns += passes[i].ns;
+    fprintf(stderr, "\n%-44s %10s %12s %10s %12s %6s\n",
+            "pass", "calls", "total ms", "avg us", "alloc KB", "%");
+    for (int i = 0; i < passes_size; ++i) {
+        jd_profile_pass *pp = &passes[i];
+        fprintf(stderr, "%-44s %10llu %12.3f %10.2f %12.1f %6.2f\n",
+                pp->name,
+                (unsigned long long)pp->calls,
+                pp->ns / 1e6,
+                pp->calls ? pp->ns / 1e3 / pp->calls : 0,
+                pp->bytes / 1024.0,
+                passes_ns ? pp->ns * 100.0 / passes_ns : 0);
+    }
+
+    size_t n = classes_size < PROFILE_TOP_CLASSES ?
+               classes_size : PROFILE_TOP_CLASSES;
+    fprintf(stderr, "\n%-60s %8s %12s %12s\n",
+            "slowest classes", "methods", "total ms", "alloc KB");
+    for (size_t i = 0; i < n; ++i) {
+        jd_profile_class *pc = &classes[i];
+        fprintf(stderr, "%-60s %8llu %12.3f %12.1f\n",
+                pc->cname,
+                (unsigned long long)pc->methods,
+                pc->ns / 1e6,
+                pc->bytes / 1024.0);
+    }
+
+    n = methods_size < PROFILE_TOP_METHODS ?
+        methods_size : PROFILE_TOP_METHODS;
+    fprintf(stderr, "\n%-60s %12s %12s  %s\n",
+            "slowest methods", "total ms", "alloc KB", "slowest pass");
+    for (size_t i = 0; i < n; ++i) {
+        jd_profile_method *pm = &methods[i];
+        char name[512];
+        snprintf(name, sizeof(name), "%s.%s", pm->cname, pm->mname);
+        fprintf(stderr, "%-60s %12.3f %12.1f  %s\n",
+                name,
+                pm->ns / 1e6,
+                pm->bytes / 1024.0,
+                pm->slowest_pass ? pm->slowest_pass : "-");
+    }
+
+    char *json = profile_path(out_dir, "garlic_profile.json");
+    char *csv = profile_path(out_dir, "garlic_profile_methods.csv");
+    profile_write_json(json, passes, passes_size,
+                       classes, classes_size,
+                       methods, methods_size);
+    profile_write_csv(csv, methods, methods_size);
+    fprintf(stderr, "\n[profile] saved to %s and %s\n", json, csv);
+    free(json);
+    free(csv);
+    free(classes);
+    free(methods);
+}
+
+// </editor-fold>
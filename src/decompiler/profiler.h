@@ -0,0 +1,62 @@
+#ifndef GARLIC_PROFILER_H
+#define GARLIC_PROFILER_H
+
+#include "decompiler/structure.h"
+
+/**
+ * --profile: wall time and pool allocation bytes of every pass, per
+ * method and per class. every thread counts into its own table without
+ * locks, the tables are only merged by profiler_report after the
+ * thread pool has been joined
+ **/
+
+typedef struct {
+    u8          ns;
+    size_t      bytes;
+    mem_pool    *pool;
+    // the enclosing method's slowest pass, lambdas nest into a pass
+    const char  *slowest_pass;
+    u8          slowest_ns;
+} jd_profile_mark;
+
+extern bool g_profile_enabled;
+
+void profiler_enable();
+
+void profiler_pass_begin(jd_profile_mark *mark);
+
+void profiler_pass_end(const char *pass, jd_profile_mark *mark);
+
+void profiler_method_begin(jd_profile_mark *mark);
+
+void profiler_method_end(jd_method *m, jd_profile_mark *mark);
+
+void profiler_report(const char *out_dir);
+
+#define PROFILE_PASS(m, pass)                                               \
+    do {                                                                    \
+        if (g_profile_enabled) {                                            \
+            jd_profile_mark _pass_mark;                                     \
+            profiler_pass_begin(&_pass_mark);                               \
+            pass(m);                                                        \
+            profiler_pass_end(#pass, &_pass_mark);                          \
+        }                                                                   \
+        else {                                                              \
+            pass(m);                                                        \
+        }                                                                   \
+    } while (0)
+
+#define PROFILE_METHOD(m, call)                                             \
+    do {                                                                    \
+        if (g_profile_enabled) {                                            \
+            jd_profile_mark _method_mark;                                   \
+            profiler_method_begin(&_method_mark);                           \
+            call;                                                           \
+            profiler_method_end(m, &_method_mark);                          \
+        }                                                                   \
+        else {                                                              \
+            call;                                                           \
+        }                                                                   \
+    } while (0)
+
+#endif //GARLIC_PROFILER_H
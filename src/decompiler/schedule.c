@@ -0,0 +1,216 @@
+#include <stdio.h>
+#include <time.h>
+#include "decompiler/schedule.h"
+
+bool g_schedule_lpt = false;
+
+// every submitted task, only read by schedule_report
+static pthread_mutex_t      schedule_lock = PTHREAD_MUTEX_INITIALIZER;
+static jd_schedule_task     **schedule_tasks = NULL;
+static size_t               schedule_tasks_size = 0;
+static size_t               schedule_tasks_capacity = 0;
+
+static inline u8 schedule_now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u8)ts.tv_sec * 1000000000ull + (u8)ts.tv_nsec;
+}
+
+void schedule_lpt_enable()
+{
+    g_schedule_lpt = true;
+}
+
+void schedule_init(jd_schedule *schedule, threadpool_t *threadpool)
+{
+    memset(schedule, 0, sizeof(jd_schedule));
+    schedule->threadpool = threadpool;
+}
+
+static void schedule_task_run(jd_schedule_task *task)
+{
+    u8 start = schedule_now_ns();
+    task->function(task->argument);
+    task->ns = schedule_now_ns() - start;
+}
+
+void schedule_add(jd_schedule *schedule,
+                  jd_schedule_fn function,
+                  void *argument,
+                  const char *name,
+                  u8 estimate)
+{
+    if (!g_schedule_lpt) {
+        threadpool_add(schedule->threadpool, function, argument, 0);
+        return;
+    }
+
+    if (schedule->size == schedule->capacity) {
+        schedule->capacity = schedule->capacity == 0 ?
+                             64 : schedule->capacity * 2;
+        schedule->tasks = realloc(schedule->tasks,
+                                  sizeof(jd_schedule_task*) *
+                                  schedule->capacity);
+    }
+    jd_schedule_task *task = malloc(sizeof(jd_schedule_task));
+    task->function = function;
+    task->argument = argument;
+    task->name = strdup(name != NULL ? name : "?");
+    task->estimate = estimate;
+    task->ns = 0;
+    task->order = schedule->size;
+    schedule->tasks[schedule->size++] = task;
+}
+
+static int cmp_task_estimate(const void *a, const void *b)
+{
+    const jd_schedule_task *ta = *(const jd_schedule_task**)a;
+    const jd_schedule_task *tb = *(const jd_schedule_task**)b;
+    if (ta->estimate != tb->estimate)
+        return ta->estimate < tb->estimate ? 1 : -1;
+    return ta->order - tb->order;
+}
+
+/**
+ * largest first: the main thread's queue is FIFO, the tasks are added in
+ * order. a worker adds to its own deque and takes from the bottom, the
+ * tasks are pushed in reverse there so the owner takes the largest first.
+ * order is the index the task was handed to the pool with
+ **/
+void schedule_submit(jd_schedule *schedule)
+{
+    if (!g_schedule_lpt || schedule->size == 0)
+        return;
+
+    qsort(schedule->tasks, schedule->size,
+          sizeof(jd_schedule_task*), cmp_task_estimate);
+
+    pthread_mutex_lock(&schedule_lock);
+    if (schedule_tasks_size + schedule->size > schedule_tasks_capacity) {
+        while (schedule_tasks_size + schedule->size > schedule_tasks_capacity)
+            schedule_tasks_capacity = schedule_tasks_capacity == 0 ?
+                                      1024 : schedule_tasks_capacity * 2;
+        schedule_tasks = realloc(schedule_tasks,
+                                 sizeof(jd_schedule_task*) *
+                                 schedule_tasks_capacity);
+    }
+    for (int i = 0; i < schedule->size; ++i)
+        schedule_tasks[schedule_tasks_size++] = schedule->tasks[i];
+    pthread_mutex_unlock(&schedule_lock);
+
+    thread_local_data *tls = get_thread_local_data();
+    bool from_worker = tls != NULL && tls->worker != NULL &&
+                       tls->worker->threadpool == schedule->threadpool;
+    for (int i = 0; i < schedule->size; ++i) {
+        int k = from_worker ? schedule->size - 1 - i : i;
+        schedule->tasks[k]->order = i;
+        threadpool_add(schedule->threadpool,
+                       &schedule_task_run,
+                       schedule->tasks[k],
+                       0);
+    }
+
+    free(schedule->tasks);
+    schedule->tasks = NULL;
+    schedule->size = schedule->capacity = 0;
+}
+
+static int cmp_task_ns(const void *a, const void *b)
+{
+    const jd_schedule_task *ta = *(const jd_schedule_task**)a;
+    const jd_schedule_task *tb = *(const jd_schedule_task**)b;
+    if (ta->ns != tb->ns)
+        return ta->ns < tb->ns ? 1 : -1;
+    return 0;
+}
+
+// newton steps on r^2 in [0, 1], garlic does not link libm
+static double schedule_correlation(double cov, double var)
+{
+    if (var <= 0 || cov == 0)
+        return 0;
+    double r2 = cov * cov / var;
+    double r = 1;
+    for (int i = 0; i < 32; ++i)
+        r = (r + r2 / r) / 2;
+    return cov < 0 ? -r : r;
+}
+
+static void schedule_write_csv(const char *path)
+{
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "[schedule] open %s failed\n", path);
+        return;
+    }
+    fprintf(fp, "class,estimate,ns,order\n");
+    for (size_t i = 0; i < schedule_tasks_size; ++i) {
+        jd_schedule_task *task = schedule_tasks[i];
+        fprintf(fp, "\"%s\",%llu,%llu,%d\n",
+                task->name,
+                (unsigned long long)task->estimate,
+                (unsigned long long)task->ns,
+                task->order);
+    }
+    fclose(fp);
+}
+
+/**
+ * called after the thread pool is joined. ns/unit turns an estimate
+ * into time, r is the correlation of estimate and actual time over all
+ * tasks, the closer to 1 the better the order
+ **/
+void schedule_report(const char *out_dir)
+{
+    if (!g_schedule_lpt || schedule_tasks_size == 0)
+        return;
+
+    size_t n = schedule_tasks_size;
+    double sum_e = 0, sum_a = 0, sum_ee = 0, sum_aa = 0, sum_ea = 0;
+    for (size_t i = 0; i < n; ++i) {
+        double e = (double)schedule_tasks[i]->estimate;
+        double a = (double)schedule_tasks[i]->ns;
+        sum_e += e;
+        sum_a += a;
+        sum_ee += e * e;
+        sum_aa += a * a;
+        sum_ea += e * a;
+    }
+    double ns_per_unit = sum_e > 0 ? sum_a / sum_e : 0;
+    double cov = n * sum_ea - sum_e * sum_a;
+    double var = (n * sum_ee - sum_e * sum_e) * (n * sum_aa - sum_a * sum_a);
+    double r = schedule_correlation(cov, var);
+
+    fprintf(stderr, "\n[schedule] %zu tasks, %.3f ms in tasks, "
+                    "%.1f ns/unit, r = %.3f\n",
+            n, sum_a / 1e6, ns_per_unit, r);
+
+    char *path = malloc(strlen(out_dir) + strlen("garlic_schedule.csv") + 2);
+    sprintf(path, "%s/%s", out_dir, "garlic_schedule.csv");
+    schedule_write_csv(path);
+
+    qsort(schedule_tasks, n, sizeof(jd_schedule_task*), cmp_task_ns);
+    size_t top = n < SCHEDULE_TOP_TASKS ? n : SCHEDULE_TOP_TASKS;
+    fprintf(stderr, "\n%-60s %10s %12s %12s %6s\n",
+            "slowest tasks", "estimate", "estimate ms", "actual ms", "order");
+    for (size_t i = 0; i < top; ++i) {
+        jd_schedule_task *task = schedule_tasks[i];
+        fprintf(stderr, "%-60s %10llu %12.3f %12.3f %6d\n",
+                task->name,
+                (unsigned long long)task->estimate,
+                task->estimate * ns_per_unit / 1e6,
+                task->ns / 1e6,
+                task->order);
+    }
+    fprintf(stderr, "\n[schedule] saved to %s\n", path);
+    free(path);
+
+    for (size_t i = 0; i < n; ++i) {
+        free(schedule_tasks[i]->name);
+        free(schedule_tasks[i]);
+    }
+    free(schedule_tasks);
+    schedule_tasks = NULL;
+    schedule_tasks_size = schedule_tasks_capacity = 0;
+}
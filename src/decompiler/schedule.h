@@ -0,0 +1,68 @@
+#ifndef GARLIC_SCHEDULE_H
+#define GARLIC_SCHEDULE_H
+
+#include "decompiler/structure.h"
+#include "libs/threadpool/threadpool.h"
+
+/**
+ * --lpt: the class tasks of a jar/dex are submitted longest processing
+ * time first, ordered by an estimate from the code sizes of the class
+ * and its nested classes, so a giant class does not start last and set
+ * the wall time of the run.
+ * only the thread that owns the queue follows this order: when a worker
+ * submits, the other workers steal from the top of its deque, which
+ * holds the cheapest tasks.
+ *
+ * without --lpt schedule_add hands the task to the pool right away.
+ * with it every task is timed and schedule_report prints the estimate
+ * against the actual time, saved to garlic_schedule.csv
+ **/
+
+// estimate of a class task beside its code, in code units
+#define SCHEDULE_CLASS_COST     64
+
+// estimate of a method beside its code, in code units
+#define SCHEDULE_METHOD_COST    8
+
+#define SCHEDULE_TOP_TASKS      10
+
+typedef void (*jd_schedule_fn)(void *argument);
+
+typedef struct {
+    jd_schedule_fn  function;
+    void            *argument;
+    char            *name;
+    u8              estimate;
+    u8              ns;
+    // index the task was handed to the pool with
+    int             order;
+} jd_schedule_task;
+
+/**
+ * the class tasks of one jar/dex, the tasks are malloc'ed and handed to
+ * the report on submit: it runs after the pools of the jar/dex are gone
+ **/
+typedef struct {
+    threadpool_t        *threadpool;
+    jd_schedule_task    **tasks;
+    int                 size;
+    int                 capacity;
+} jd_schedule;
+
+extern bool g_schedule_lpt;
+
+void schedule_lpt_enable();
+
+void schedule_init(jd_schedule *schedule, threadpool_t *threadpool);
+
+void schedule_add(jd_schedule *schedule,
+                  jd_schedule_fn function,
+                  void *argument,
+                  const char *name,
+                  u8 estimate);
+
+void schedule_submit(jd_schedule *schedule);
+
+void schedule_report(const char *out_dir);
+
+#endif //GARLIC_SCHEDULE_H
@@ -1,4 +1,5 @@
 #include "decompiler/ssa.h"
+#include "decompiler/dataflow.h"
 #include "common/endian_x.h"
 #include "common/str_tools.h"
 #include "jvm/jvm_ins.h"
@@ -94,48 +95,14 @@ void prepare_local_variable_kill_and_gen(jd_method *m)
 
 void process_local_variable_liveness(jd_method *m)
 {
-    int block_size = m->basic_blocks->size;
-    int max_locals = m->max_locals;
-    bool changed = true;
-    int k = 0;
-    do {
-        changed = false;
-        for (int i = block_size-1; i >= 0; --i) {
-            jd_bblock *bblock = lget_obj(m->basic_blocks, i);
-            if (bblock->type != JD_BB_NORMAL)
-                continue;
-            bitset_t *prev_live_in = lget_object(m->live_ins, i);
-            bitset_t *prev_live_out = lget_object(m->live_outs, i);
-            bitset_t *new_live_in = bitset_create_with_capacity(max_locals);
-            bitset_t *new_live_out = bitset_create_with_capacity(max_locals);
-
-            for (int j = 0; j < bblock->out->size; ++j) {
-                jd_edge *edge = lget_obj(bblock->out, j);
-                bitset_t *in = lget_obj(m->live_ins, edge->target_block_id);
-                bitset_inplace_union(new_live_out, in);
-            }
-
-            bitset_t *copy_live_out = bitset_copy(new_live_out);
-            bitset_inplace_difference(copy_live_out, lget_obj(m->defs, i));
-            bitset_inplace_union(new_live_in, lget_obj(m->uses, i));
-            bitset_inplace_union(new_live_in, copy_live_out);
-
-            if (bitset_symmetric_difference_count(prev_live_in, new_live_in) > 0) {
-                memcpy(lget_obj(m->live_ins, i), new_live_in, sizeof(bitset_t));
-                changed = true;
-            }
-
-            if (bitset_symmetric_difference_count(prev_live_out, new_live_out) > 0) {
-                memcpy(lget_obj(m->live_outs, i), new_live_out, sizeof(bitset_t));
-                changed = true;
-            }
-
-            k++;
-            if (k > block_size*10)
-                DEBUG_SSA_PRINT("error\n");
-        }
-
-    } while (changed);
+    jd_dataflow df = {
+        .direction = JD_DATAFLOW_BACKWARD,
+        .meets = m->live_outs,
+        .results = m->live_ins,
+        .gens = m->uses,
+        .kills = m->defs,
+    };
+    dataflow_solve(m, &df);
 }
 
 void process_local_variable_live_intervals(jd_method *m)
@@ -191,43 +158,15 @@ void process_local_variable_live_intervals(jd_method *m)
 
 void process_local_variable_reaching_defination(jd_method *m)
 {
-    int block_size = m->basic_blocks->size;
-    int max_locals = m->max_locals;
-    bool changed = true;
-    do {
-        changed = false;
-        for (int i = 0; i < block_size; ++i) {
-            jd_bblock *bblock = lget_obj(m->basic_blocks, i);
-            if (bblock->type != JD_BB_NORMAL)
-                continue;
-            bitset_t *prev_reaching_out = lget_obj(m->reaching_out, i);
-            bitset_t *prev_reaching_in = lget_obj(m->reaching_in, i);
-            bitset_t *new_reaching_in = bitset_create_with_capacity(max_locals);
-            bitset_t *new_reaching_out = NULL;
-            for (int j = 0; j < bblock->in->size; ++j) {
-                jd_edge *edge = lget_obj(bblock->in, j);
-                bitset_t *in_reaching_out = lget_obj(m->reaching_out, edge->source_block_id);
-                bitset_inplace_union(new_reaching_in, in_reaching_out);
-            }
-
-            bitset_t *def = lget_obj(m->defs, i);
-            new_reaching_out = bitset_copy(new_reaching_in);
-            for (size_t k = 0; bitset_next_set_bit(def, &k); k++) {
-                bitset_set_to_value(new_reaching_out, k, false);
-            }
-            bitset_inplace_union(new_reaching_out, def);
-            if (bitset_symmetric_difference_count(prev_reaching_out, new_reaching_out) > 0) {
-                memcpy(lget_obj(m->reaching_out, i), new_reaching_out, sizeof(bitset_t));
-                changed = true;
-            }
-            if (bitset_symmetric_difference_count(prev_reaching_in, new_reaching_in) > 0) {
-                memcpy(lget_obj(m->reaching_in, i), new_reaching_in, sizeof(bitset_t));
-                changed = true;
-            }
-        }
-
-    } while (changed);
-
+    // out = (in - defs) U defs
+    jd_dataflow df = {
+        .direction = JD_DATAFLOW_FORWARD,
+        .meets = m->reaching_in,
+        .results = m->reaching_out,
+        .gens = m->defs,
+        .kills = m->defs,
+    };
+    dataflow_solve(m, &df);
 }
 
 void print_local_variable_liveness(jd_method *m)
@@ -491,7 +430,8 @@ void sform_local_variable_rename(jd_method *m)
     for (int i = 0; i < max_locals; ++i) {
         queue_object *stack = queue_init_object();
         ladd_obj(stacks, stack);
-        counter[i] = 0;
+        // version 0 is the value from the method entry, defs start at 1
+        counter[i] = 1;
     }
     sform_init_enter_state(m, counter, stacks);
     jd_bblock *enter = lget_obj(m->basic_blocks, 3);
@@ -5,6 +5,7 @@
 
 #include "parser/class/class_structure.h"
 #include "libs/hashmap/hashmap_tools.h"
+#include "libs/hashmap/intern.h"
 #include "libs/bitset/bitset.h"
 #include "libs/queue/queue.h"
 #include "libs/zip/zip.h"
@@ -24,6 +25,7 @@ typedef struct jd_exp               jd_exp;
 typedef struct jd_node              jd_node;
 typedef struct jd_synthetic_class   jd_synthetic_class;
 typedef struct jd_var               jd_var;
+typedef struct jd_block_index       jd_block_index;
 
 typedef char* (*jd_access_flag_fn) (void *ptr, str_list *list);
 
@@ -845,6 +847,7 @@ enum method_state_flag {
     METHOD_STATE_LAMBDA        = 0x0001,
     METHOD_STATE_HIDE          = 0x0002,
     METHOD_STATE_UNSUPPORT     = 0x0004,
+    METHOD_STATE_TRUNCATED     = 0x0008,
 };
 
 typedef struct {
@@ -868,6 +871,7 @@ typedef struct jd_variable_scope {
 typedef bool (*jd_method_filter_fn)(jd_method *m);
 typedef char* (*jd_meth_param_annotation_fn)(jd_method *m, int index);
 typedef jd_val* (*jd_meth_param_val_fn)(jd_method *m, int index);
+typedef void (*jd_meth_write_fn)(jd_method *m, FILE *stream);
 
 typedef struct jd_method_fn {
     jd_method_filter_fn is_native;
@@ -880,6 +884,8 @@ typedef struct jd_method_fn {
     jd_access_flag_fn access_flags_fn;
     jd_meth_param_val_fn param_val_fn;
     jd_meth_param_annotation_fn param_annotation_fn;
+    // bytecode/smali listing of a method cut off by the budget
+    jd_meth_write_fn bytecode_fn;
 } jd_method_fn;
 
 struct jd_method {
@@ -911,7 +917,20 @@ struct jd_method {
 
     hashmap         *slot_counter_map;
 
-    hashmap         *offset2id_map;
+    /**
+     * dense offset -> instruction, catches up with the instructions
+     * appended since the last lookup, see ins_of_offset
+     **/
+    void            **offset2ins;
+    uint32_t        offset2ins_size;
+    uint32_t        offset2ins_synced;
+
+    // offset -> basic block lookups, see control_flow.c
+    jd_block_index  *block_index;
+
+    // see method_budget.h
+    u8              budget_start_ns;
+    string          truncated;
 
     hashmap         *class_counter_map;
 
@@ -1040,6 +1059,9 @@ struct jd_basic_block {
     list_object             *frontier;
     list_object             *dominates;
     jd_bblock               *idom;
+    // dominator tree dfs interval, 0 until numbered by dominator_tree
+    int                     dom_pre;
+    int                     dom_post;
 
     jd_method               *method;
     jd_node                 *node;
@@ -1124,9 +1146,14 @@ struct jd_jar {
     int             added;
     int             done;
     struct zip_t    *zip;
+    // zip reader of every thread, slot 0 is the main thread's zip
+    struct zip_t    **zips;
+    int             zips_size;
 
     threadpool_t    *threadpool;
     pthread_mutex_t *lock;
+    // constant pool strings of every class, shared by the workers
+    jd_intern       *intern;
 };
 
 struct jsource_file {
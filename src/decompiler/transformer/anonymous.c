@@ -8,17 +8,19 @@ string exp_anonymous_to_s(jd_exp *expression)
     return NULL;
 }
 
-void exp_anonymous_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_anonymous_to_stream(jd_emitter *stream,
+                             jd_node *node,
+                             jd_exp *expression)
 {
     jd_exp_anonymous *anaonymous = expression->data;
-    fprintf(stream, "new %s(", anaonymous->cname);
+    emit_printf(stream, "new %s(", anaonymous->cname);
     for (int i = 1; i < anaonymous->list->len; ++i) {
         jd_exp *arg = &anaonymous->list->args[i];
         expression_to_stream(stream, node, arg);
         if (i != anaonymous->list->len - 1)
-            fprintf(stream, ", ");
+            emit_str(stream, ", ");
     }
-    fprintf(stream, ") {\n");
+    emit_str(stream, ") {\n");
     jsource_file *inner = anaonymous->jfile;
     jd_node *root_node = lget_obj_first(inner->blocks);
     jd_node *class_node = NULL;
@@ -29,7 +31,7 @@ void exp_anonymous_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
     }
     assert(class_node != NULL);
     class_node->parent = node;
-    writter_for_anonymous_class(anaonymous->jfile, class_node);
-    string ident = get_node_ident(node);
-    fprintf(stream, "%s}", ident);
+    writter_for_anonymous_class(stream, anaonymous->jfile, class_node);
+    emit_ident(stream, node);
+    emit_char(stream, '}');
 }
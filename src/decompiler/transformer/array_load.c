@@ -10,14 +10,16 @@ string exp_array_load_to_s(jd_exp *expression)
     return str_create("%s[%s]", array, index);
 }
 
-void exp_array_load_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_array_load_to_stream(jd_emitter *stream,
+                              jd_node *node,
+                              jd_exp *expression)
 {
     jd_exp_array_load *array_load = expression->data;
     jd_exp *array_exp = &array_load->list->args[1];
     jd_exp *index_exp = &array_load->list->args[0];
 
     expression_to_stream(stream, node, array_exp);
-    fprintf(stream, "[");
+    emit_str(stream, "[");
     expression_to_stream(stream, node, index_exp);
-    fprintf(stream, "]");
+    emit_str(stream, "]");
 }
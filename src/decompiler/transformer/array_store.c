@@ -10,7 +10,9 @@ string exp_array_store_to_s(jd_exp *expression)
     return str_create("%s[%s] = %s", array_name, index_name, value_name);
 }
 
-void exp_array_store_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_array_store_to_stream(jd_emitter *stream,
+                               jd_node *node,
+                               jd_exp *expression)
 {
     jd_exp_array_store *array_store = expression->data;
     jd_exp *array = &array_store->list->args[2];
@@ -18,8 +20,8 @@ void exp_array_store_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
     jd_exp *value = &array_store->list->args[0];
 
     expression_to_stream(stream, node, array);
-    fprintf(stream, "[");
+    emit_str(stream, "[");
     expression_to_stream(stream, node, index);
-    fprintf(stream, "] = ");
+    emit_str(stream, "] = ");
     expression_to_stream(stream, node, value);
 }
@@ -8,10 +8,12 @@ string exp_arraylength_to_s(jd_exp *expression)
     return str_create("%s.length", array);
 }
 
-void exp_arraylength_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_arraylength_to_stream(jd_emitter *stream,
+                               jd_node *node,
+                               jd_exp *expression)
 {
     jd_exp_arraylength *arraylength = expression->data;
 
     expression_to_stream(stream, node, &arraylength->list->args[0]);
-    fprintf(stream, ".length");
+    emit_str(stream, ".length");
 }
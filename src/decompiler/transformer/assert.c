@@ -6,11 +6,11 @@ string exp_assert_to_s(jd_exp *expression)
     return str_create("assert(%s)", exp_to_s(inner_expression));
 }
 
-void exp_assert_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_assert_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp *inner_expression = expression->data;
 
-    fprintf(stream, "assert(");
+    emit_str(stream, "assert(");
     expression_to_stream(stream, node, inner_expression);
-    fprintf(stream, ")");
+    emit_str(stream, ")");
 }
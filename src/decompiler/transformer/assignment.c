@@ -11,7 +11,9 @@ string exp_assignment_to_s(jd_exp *expression)
     return str_create("%s %s %s", lstr, op_name, rstr);
 }
 
-void exp_assignment_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_assignment_to_stream(jd_emitter *stream,
+                              jd_node *node,
+                              jd_exp *expression)
 {
     jd_exp_assignment *assignment = expression->data;
     string op_name = get_operator_name(assignment->assign_operator);
@@ -19,6 +21,6 @@ void exp_assignment_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
     jd_exp *left = assignment->left;
 
     expression_to_stream(stream, node, left);
-    fprintf(stream, " %s ", op_name);
+    emit_printf(stream, " %s ", op_name);
     expression_to_stream(stream, node, right);
 }
@@ -28,7 +28,7 @@ string exp_assignment_chain_to_s(jd_exp *expression)
     return result;
 }
 
-void exp_assignment_chain_to_stream(FILE *stream,
+void exp_assignment_chain_to_stream(jd_emitter *stream,
                                     jd_node *node,
                                     jd_exp *expression)
 {
@@ -37,7 +37,7 @@ void exp_assignment_chain_to_stream(FILE *stream,
     for (int i = 0; i < assignment_chain->left->size; ++i) {
         jd_exp *l = lget_obj(assignment_chain->left, i);
         expression_to_stream(stream, node, l);
-        fprintf(stream, " = ");
+        emit_str(stream, " = ");
     }
     jd_exp *right = assignment_chain->right;
     expression_to_stream(stream, node, right);
@@ -8,9 +8,9 @@ string exp_athrow_to_s(jd_exp *expression)
     return str_create("throw %s", exception);
 }
 
-void exp_athrow_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_athrow_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_athrow *athrow = expression->data;
-    fprintf(stream, "throw ");
+    emit_str(stream, "throw ");
     expression_to_stream(stream, node, &athrow->list->args[0]);
 }
@@ -9,7 +9,7 @@ string exp_cast_to_s(jd_exp *expression)
     return str_create("(%s)%s", cast->class_name, original);
 }
 
-void exp_cast_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_cast_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     // https://bugs.java.com/bugdatabase/view_bug?bug_id=6246854
     // DK-6246854 : Unnecessary checkcast in generated code
@@ -23,7 +23,7 @@ void exp_cast_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
         }
     }
     else {
-        fprintf(stream, "(%s)", cast->class_name);
+        emit_printf(stream, "(%s)", cast->class_name);
         expression_to_stream(stream, node, arg);
     }
 
@@ -70,7 +70,61 @@ string exp_const_to_s(jd_exp *expression)
     return get_const_value(expression);
 }
 
-void exp_const_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+// str_replace_nl written in place
+static void emit_string_const(jd_emitter *stream, string val)
 {
-    fprintf(stream, "%s", get_const_value(expression));
+    emit_char(stream, '"');
+    for (string p = val; *p; ++p) {
+        if (*p == '\n')
+            emit_bytes(stream, "\\n", 2);
+        else
+            emit_char(stream, *p);
+    }
+    emit_char(stream, '"');
+}
+
+void exp_const_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
+{
+    jd_exp_const *const_exp = expression->data;
+    jd_val_data *data = const_exp->val->data;
+    jd_primitive_union *primitive = data->primitive;
+
+    switch (const_exp->val->type) {
+        case JD_VAR_INT_T: {
+            if (const_exp_is_boolean(const_exp) &&
+                primitive->int_val == 0)
+                emit_str(stream, "false");
+            else if (const_exp_is_boolean(const_exp) &&
+                     primitive->int_val == 1)
+                emit_str(stream, "true");
+            else
+                emit_printf(stream, "%d", primitive->int_val);
+            break;
+        }
+        case JD_VAR_LONG_T:
+            emit_printf(stream, "%ldL", primitive->long_val);
+            break;
+        case JD_VAR_FLOAT_T:
+            emit_printf(stream, "%f", primitive->float_val);
+            break;
+        case JD_VAR_DOUBLE_T:
+            emit_printf(stream, "%lf", primitive->double_val);
+            break;
+        case JD_VAR_NULL_T:
+            emit_str(stream, "null");
+            break;
+        case JD_VAR_REFERENCE_T: {
+            if (const_exp_is_string(const_exp))
+                emit_string_const(stream, data->val);
+            else if (const_exp_is_class(const_exp))
+                emit_printf(stream, "%s.class",
+                            class_simple_name(data->val));
+            else
+                emit_printf(stream, "%s", data->val);
+            break;
+        }
+        default:
+            emit_str(stream, g_str_unknown);
+            break;
+    }
 }
@@ -7,10 +7,12 @@ string exp_declaration_to_s(jd_exp *expression)
 
 }
 
-void exp_declaration_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_declaration_to_stream(jd_emitter *stream,
+                               jd_node *node,
+                               jd_exp *expression)
 {
     jd_variable_scope *scope = expression->data;
-    fprintf(stream, "%s", scope->cname);
-    fprintf(stream, " ");
-    fprintf(stream, "%s", scope->name);
+    emit_printf(stream, "%s", scope->cname);
+    emit_str(stream, " ");
+    emit_printf(stream, "%s", scope->name);
 }
@@ -12,7 +12,7 @@ string exp_define_stack_var_to_s(jd_exp *expression)
     return str_create("%s = %s", lstr, rstr);
 }
 
-void exp_define_stack_var_to_stream(FILE *stream,
+void exp_define_stack_var_to_stream(jd_emitter *stream,
                                     jd_node *node,
                                     jd_exp *expression)
 {
@@ -21,6 +21,6 @@ void exp_define_stack_var_to_stream(FILE *stream,
     jd_exp *right = &exp_stack_var->list->args[1];
 
     expression_to_stream(stream, node, left);
-    fprintf(stream, " = ");
+    emit_str(stream, " = ");
     expression_to_stream(stream, node, right);
 }
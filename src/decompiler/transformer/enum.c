@@ -5,17 +5,17 @@ string exp_enum_to_s(jd_exp *expression)
     return str_create("unknown %d", expression->type);
 }
 
-void exp_enum_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_enum_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_enum *enum_exp = expression->data;
     for (int i = 0; i < enum_exp->list->size; ++i) {
         jd_exp_num_item *item = lget_obj(enum_exp->list, i);
         if (item->list->len > 2)
-            fprintf(stream, "%s(", item->name);
+            emit_printf(stream, "%s(", item->name);
         else {
-            fprintf(stream, "%s", item->name);
+            emit_printf(stream, "%s", item->name);
             if (i != enum_exp->list->size - 1)
-                fprintf(stream, ",");
+                emit_str(stream, ",");
 
             continue;
         }
@@ -24,17 +24,17 @@ void exp_enum_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
             jd_exp *exp = &item->list->args[j];
             expression_to_stream(stream, node, exp);
             if (j != item->list->len - 1)
-                fprintf(stream, ", ");
+                emit_str(stream, ", ");
         }
         if (i == enum_exp->list->size - 1) {
             if (item->list->len > 2)
-                fprintf(stream, ")");
+                emit_str(stream, ")");
         }
         else {
             if (item->list->len > 2)
-                fprintf(stream, "), ");
+                emit_str(stream, "), ");
             else
-                fprintf(stream, ", ");
+                emit_str(stream, ", ");
         }
     }
 }
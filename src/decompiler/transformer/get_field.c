@@ -8,12 +8,14 @@ string exp_get_field_to_s(jd_exp *expression)
     return str_create("%s.%s", exp_str, getfield->name);
 }
 
-void exp_get_field_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_get_field_to_stream(jd_emitter *stream,
+                             jd_node *node,
+                             jd_exp *expression)
 {
     jd_exp_get_field *getfield = expression->data;
     string name = getfield->name;
 
     jd_exp *exp = &getfield->list->args[0];
     expression_to_stream(stream, node, exp);
-    fprintf(stream, ".%s", name);
+    emit_printf(stream, ".%s", name);
 }
@@ -23,20 +23,22 @@ string exp_if_break_to_s(jd_exp *expression)
                       if_exp->offset);
 }
 
-void exp_if_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_if_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_if *if_exp = expression->data;
     jd_exp *condition = if_exp->expression;
     expression_to_stream(stream, node, condition);
     if (DEBUG_INS_AND_NODE_INFO)
-        fprintf(stream, " /* target: %d */", if_exp->offset);
+        emit_printf(stream, " /* target: %d */", if_exp->offset);
 }
 
-void exp_if_break_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_if_break_to_stream(jd_emitter *stream,
+                            jd_node *node,
+                            jd_exp *expression)
 {
     jd_exp_if *if_exp = expression->data;
     jd_exp *condition = if_exp->expression;
-    fprintf(stream, "if (");
+    emit_str(stream, "if (");
     expression_to_stream(stream, node, condition);
-    fprintf(stream, " ) break; /* target: %d */", if_exp->offset);
+    emit_printf(stream, " ) break; /* target: %d */", if_exp->offset);
 }
\ No newline at end of file
@@ -27,18 +27,20 @@ string exp_initialize_to_s(jd_exp *expression)
 }
 
 
-void exp_initialize_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_initialize_to_stream(jd_emitter *stream,
+                              jd_node *node,
+                              jd_exp *expression)
 {
     jd_exp_initialize *initialize = expression->data;
-    fprintf(stream, "new %s(", initialize->class_name);
+    emit_printf(stream, "new %s(", initialize->class_name);
 
     jd_exp_list *list = initialize->list;
     if (list->len > 0) {
         for (int i = 0; i < initialize->list->len; ++i) {
             expression_to_stream(stream, node, &list->args[i]);
             if (i != list->len - 1)
-                fprintf(stream, ", ");
+                emit_str(stream, ", ");
         }
     }
-    fprintf(stream, ")");
+    emit_str(stream, ")");
 }
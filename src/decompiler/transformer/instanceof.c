@@ -8,11 +8,13 @@ string exp_instanceof_to_s(jd_exp *expression)
     return str_create("(%s instanceof %s)", exp, instanceof->class_name);
 }
 
-void exp_instanceof_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_instanceof_to_stream(jd_emitter *stream,
+                              jd_node *node,
+                              jd_exp *expression)
 {
     jd_exp_instanceof *instanceof = expression->data;
     string class_name = instanceof->class_name;
-    fprintf(stream, "(");
+    emit_str(stream, "(");
     expression_to_stream(stream, node, &instanceof->list->args[0]);
-    fprintf(stream, " instanceof %s)", class_name);
+    emit_printf(stream, " instanceof %s)", class_name);
 }
@@ -92,7 +92,7 @@ string exp_invoke_to_s(jd_exp *expression)
 }
 
 
-void exp_invoke_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_invoke_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     if (jvm_ins_is_invokevirtual(expression->ins) ||
         jvm_ins_is_invokeinterface(expression->ins) ||
@@ -103,31 +103,31 @@ void exp_invoke_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
 
         jd_exp *arg_exp = &invoke->list->args[invoke->list->len - 1];
         if (jvm_ins_is_invokespecial(expression->ins)) {
-            fprintf(stream, "new ");
+            emit_str(stream, "new ");
             expression_to_stream(stream, node, arg_exp);
-            fprintf(stream, ".%s(", method_name);
+            emit_printf(stream, ".%s(", method_name);
         }
         else {
             expression_to_stream(stream, node, arg_exp);
-            fprintf(stream, ".%s(", method_name);
+            emit_printf(stream, ".%s(", method_name);
         }
 
         for (int j = 0; j <= invoke->list->len - 2; ++j) {
             expression_to_stream(stream, node, &invoke->list->args[j]);
             if (j != invoke->list->len - 2)
-                fprintf(stream, ", ");
+                emit_str(stream, ", ");
         }
-        fprintf(stream, ")");
+        emit_str(stream, ")");
     }
     else {
         jd_exp_invoke *invoke = expression->data;
         string method_name = invoke->method_name;
-        fprintf(stream, "%s(", method_name);
+        emit_printf(stream, "%s(", method_name);
         for (int j = 0; j <= invoke->list->len - 1; ++j) {
             expression_to_stream(stream, node, &invoke->list->args[j]);
             if (j != invoke->list->len - 1)
-                fprintf(stream, ", ");
+                emit_str(stream, ", ");
         }
-        fprintf(stream, ")");
+        emit_str(stream, ")");
     }
 }
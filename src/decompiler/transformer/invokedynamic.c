@@ -25,17 +25,17 @@ string exp_invokedynamic_to_s(jd_exp *expression)
     return s;
 }
 
-void exp_invokedynamic_to_stream(FILE *stream,
+void exp_invokedynamic_to_stream(jd_emitter *stream,
                                  jd_node *node,
                                  jd_exp *expression)
 {
     jd_exp_invoke *invoke = expression->data;
     string method_name = invoke->method_name;
-    fprintf(stream, "%s(", method_name);
+    emit_printf(stream, "%s(", method_name);
     for (int j = 0; j <= invoke->list->len - 1; ++j) {
         expression_to_stream(stream, node, &invoke->list->args[j]);
         if (j != invoke->list->len - 1)
-            fprintf(stream, ", ");
+            emit_str(stream, ", ");
     }
-    fprintf(stream, ")");
+    emit_str(stream, ")");
 }
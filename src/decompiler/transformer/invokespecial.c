@@ -56,7 +56,7 @@ string exp_invokespecial_to_s(jd_exp *expression)
     return result;
 }
 
-void exp_invokespecial_to_stream(FILE *stream,
+void exp_invokespecial_to_stream(jd_emitter *stream,
                                  jd_node *node,
                                  jd_exp *expression)
 {
@@ -65,30 +65,41 @@ void exp_invokespecial_to_stream(FILE *stream,
     string current_method_name = expression->ins->method->name;
 
     jd_exp *ref_exp = &invoke->list->args[invoke->list->len - 1];
-    string object_ref_str = exp_to_s(ref_exp);
 
-    if (STR_EQL(object_ref_str, g_str_this) &&
-        (!STR_EQL(method_name, g_str_init) &&
-         STR_EQL(current_method_name, method_name))) {
-        fprintf(stream, "super.%s(", method_name);
-    }
-    else if (/*STR_EQL(object_ref_str, g_str_this) &&*/
-             STR_EQL(method_name, g_str_init) &&
-             STR_EQL(current_method_name, g_str_init)) {
-        fprintf(stream, "super(");
-    }
-    else if (!STR_EQL(method_name, g_str_init)) {
-        // invoke private m
-        fprintf(stream, "%s.%s(", object_ref_str, method_name);
+    if (!STR_EQL(method_name, g_str_init)) {
+        // the object ref is written in place and taken back for super
+        size_t mark = stream->size;
+        expression_to_stream(stream, node, ref_exp);
+        if (emit_since_equals(stream, mark, g_str_this) &&
+            STR_EQL(current_method_name, method_name)) {
+            stream->size = mark;
+            emit_printf(stream, "super.%s(", method_name);
+        }
+        else {
+            // invoke private m
+            emit_printf(stream, ".%s(", method_name);
+        }
     }
     else {
-        fprintf(stream, "new %s.%s(", object_ref_str, method_name);
+        // this.<init> in a constructor is the super call
+        size_t start = stream->size;
+        emit_str(stream, "new ");
+        size_t mark = stream->size;
+        expression_to_stream(stream, node, ref_exp);
+        if (emit_since_equals(stream, mark, g_str_this) &&
+            STR_EQL(current_method_name, g_str_init)) {
+            stream->size = start;
+            emit_str(stream, "super(");
+        }
+        else {
+            emit_printf(stream, ".%s(", method_name);
+        }
     }
 
     for (int j = 0; j <= invoke->list->len - 2; ++j) {
         expression_to_stream(stream, node, &invoke->list->args[j]);
         if (j != invoke->list->len - 2)
-            fprintf(stream, ", ");
+            emit_str(stream, ", ");
     }
-    fprintf(stream, ")");
+    emit_str(stream, ")");
 }
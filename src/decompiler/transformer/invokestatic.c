@@ -28,18 +28,18 @@ string exp_invokestatic_to_s(jd_exp *expression)
     return s;
 }
 
-void exp_invokestatic_to_stream(FILE *stream,
+void exp_invokestatic_to_stream(jd_emitter *stream,
                                 jd_node *node,
                                 jd_exp *expression)
 {
     jd_exp_invoke *invoke = expression->data;
     string method_name = invoke->method_name;
     string class_name = invoke->class_name;
-    fprintf(stream, "%s.%s(", class_name, method_name);
+    emit_printf(stream, "%s.%s(", class_name, method_name);
     for (int j = 0; j <= invoke->list->len - 1; ++j) {
         expression_to_stream(stream, node, &invoke->list->args[j]);
         if (j != invoke->list->len - 1)
-            fprintf(stream, ", ");
+            emit_str(stream, ", ");
     }
-    fprintf(stream, ")");
+    emit_str(stream, ")");
 }
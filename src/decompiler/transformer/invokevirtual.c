@@ -29,7 +29,7 @@ string exp_invokevirtual_to_s(jd_exp *expression)
     return result;
 }
 
-void exp_invokevirtual_to_stream(FILE *stream,
+void exp_invokevirtual_to_stream(jd_emitter *stream,
                                  jd_node *node,
                                  jd_exp *expression)
 {
@@ -38,12 +38,12 @@ void exp_invokevirtual_to_stream(FILE *stream,
 
     jd_exp *ref_exp = &invoke->list->args[invoke->list->len - 1];
     expression_to_stream(stream, node, ref_exp);
-    fprintf(stream, ".%s(", method_name);
+    emit_printf(stream, ".%s(", method_name);
 
     for (int j = 0; j <= invoke->list->len - 2; ++j) {
         expression_to_stream(stream, node, &invoke->list->args[j]);
         if (j != invoke->list->len - 2)
-            fprintf(stream, ", ");
+            emit_str(stream, ", ");
     }
-    fprintf(stream, ")");
+    emit_str(stream, ")");
 }
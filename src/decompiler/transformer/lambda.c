@@ -43,7 +43,7 @@ string exp_lambda_to_s(jd_exp *expression)
     }
 }
 
-void exp_lambda_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_lambda_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_lambda *exp_lambda = expression->data;
     jd_method *m = exp_lambda->method;
@@ -51,32 +51,32 @@ void exp_lambda_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
         if (exp_lambda->is_static && exp_lambda->list->len > 0) {
             jd_exp *first = &exp_lambda->list->args[0];
             expression_to_stream(stream, node, first);
-            fprintf(stream, "::%s", exp_lambda->method_name);
+            emit_printf(stream, "::%s", exp_lambda->method_name);
         }
         else
-            fprintf(stream, "%s::%s",
-                    class_simple_name(exp_lambda->class_name),
-                    exp_lambda->method_name);
+            emit_printf(stream, "%s::%s",
+                       class_simple_name(exp_lambda->class_name),
+                       exp_lambda->method_name);
     }
     else {
         if (method_is_synthetic(m)) {
             string defination = create_lambda_defination(m);
-            string ident = get_node_ident(node);
-            fprintf(stream, "%s {\n", defination);
+            emit_printf(stream, "%s {\n", defination);
             jd_node *root = lget_obj(m->nodes, 0);
             root->parent = node;
-            writter_for_class(m->jfile, root);
-            fprintf(stream, "%s}", ident);
+            writter_for_class_nodes(stream, m->jfile, root);
+            emit_ident(stream, node);
+            emit_char(stream, '}');
         }
         else {
             if (method_is_member(m) && exp_lambda->list->len > 0) {
                 jd_exp *first_exp = &exp_lambda->list->args[0];
                 expression_to_stream(stream, node, first_exp);
-                fprintf(stream, "::%s", m->name);
+                emit_printf(stream, "::%s", m->name);
             }
             else
-                fprintf(stream, "%s::%s",
-                        exp_lambda->class_name, m->name);
+                emit_printf(stream, "%s::%s",
+                           exp_lambda->class_name, m->name);
         }
     }
 }
@@ -33,9 +33,9 @@ string exp_local_variable_to_s(jd_exp *expression)
     return val->name;
 }
 
-void exp_local_variable_to_stream(FILE *stream, 
+void exp_local_variable_to_stream(jd_emitter *stream, 
                                 jd_node *node, jd_exp *expression)
 {
     jd_val *val = expression->data;
-    fprintf(stream, "%s", val->name);
+    emit_printf(stream, "%s", val->name);
 }
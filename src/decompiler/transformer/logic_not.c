@@ -8,10 +8,12 @@ string exp_logic_not_to_s(jd_exp *expression)
     return str_create("!(%s)", condition);
 }
 
-void exp_logic_not_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_logic_not_to_stream(jd_emitter *stream,
+                             jd_node *node,
+                             jd_exp *expression)
 {
     jd_exp_logic_not *logic_not = expression->data;
-    fprintf(stream, "!(");
+    emit_str(stream, "!(");
     expression_to_stream(stream, node, &logic_not->list->args[0]);
-    fprintf(stream, ")");
+    emit_str(stream, ")");
 }
@@ -14,13 +14,13 @@ string exp_break_to_s(jd_exp *expression)
     }
 }
 
-void exp_break_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_break_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_goto *exp_goto = expression->data;
     if (DEBUG_INS_AND_NODE_INFO)
-        fprintf(stream, "break; // %u", exp_goto->goto_offset);
+        emit_printf(stream, "break; // %u", exp_goto->goto_offset);
     else
-        fprintf(stream, "break");
+        emit_str(stream, "break");
 }
 
 string exp_continue_to_s(jd_exp *expression)
@@ -35,13 +35,15 @@ string exp_continue_to_s(jd_exp *expression)
     }
 }
 
-void exp_continue_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_continue_to_stream(jd_emitter *stream,
+                            jd_node *node,
+                            jd_exp *expression)
 {
     jd_exp_goto *exp_goto = expression->data;
     if (DEBUG_INS_AND_NODE_INFO)
-        fprintf(stream, "continue; // %u", exp_goto->goto_offset);
+        emit_printf(stream, "continue; // %u", exp_goto->goto_offset);
     else
-        fprintf(stream, "continue");
+        emit_str(stream, "continue");
 }
 
 static string exp_loop_to_s(jd_exp *expression, string loop_name)
@@ -73,7 +75,7 @@ string exp_while_to_s(jd_exp *expression)
     return exp_loop_to_s(expression, "while");
 }
 
-void exp_while_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_while_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_loop *exp_loop = expression->data;
     expression_to_stream(stream, node, &exp_loop->list->args[0]);
@@ -84,7 +86,9 @@ string exp_do_while_to_s(jd_exp *expression)
     return exp_loop_to_s(expression, "do_while");
 }
 
-void exp_do_while_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_do_while_to_stream(jd_emitter *stream,
+                            jd_node *node,
+                            jd_exp *expression)
 {
     jd_exp_loop *exp_loop = expression->data;
     expression_to_stream(stream, node, &exp_loop->list->args[0]);
@@ -100,13 +104,13 @@ string exp_for_to_s(jd_exp *expression)
     return str_create("for(%s; %s; %s)", s1, s2, s3);
 }
 
-void exp_for_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_for_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_for *for_exp = expression->data;
 
     expression_to_stream(stream, node, &for_exp->list->args[0]);
-    fprintf(stream, "; ");
+    emit_str(stream, "; ");
     expression_to_stream(stream, node, &for_exp->list->args[1]);
-    fprintf(stream, "; ");
+    emit_str(stream, "; ");
     expression_to_stream(stream, node, &for_exp->list->args[2]);
 }
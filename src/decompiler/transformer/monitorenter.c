@@ -8,7 +8,7 @@ string exp_monitorenter_to_s(jd_exp *expression)
     return exp_to_s(exp);
 }
 
-void exp_monitorenter_to_stream(FILE *stream,
+void exp_monitorenter_to_stream(jd_emitter *stream,
                                 jd_node *node,
                                 jd_exp *expression)
 {
@@ -10,7 +10,9 @@ string exp_monitorexit_to_s(jd_exp *expression)
     return exp_to_s(exp);
 }
 
-void exp_monitorexit_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_monitorexit_to_stream(jd_emitter *stream,
+                               jd_node *node,
+                               jd_exp *expression)
 {
     jd_exp_monitorenter *enter = expression->data;
     jd_exp *exp = &enter->list->args[0];
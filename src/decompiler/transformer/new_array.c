@@ -31,19 +31,21 @@ string exp_new_array_to_s(jd_exp *expression)
 }
 
 
-void exp_new_array_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_new_array_to_stream(jd_emitter *stream,
+                             jd_node *node,
+                             jd_exp *expression)
 {
     jd_exp_new_array *new_array = expression->data;
-    fprintf(stream, "new %s[", new_array->class_name);
+    emit_printf(stream, "new %s[", new_array->class_name);
     // expression_to_stream(stream, node, &new_array->list->args[0]);
-    fprintf(stream, "]");
+    emit_str(stream, "]");
 
-    fprintf(stream, "{");
+    emit_str(stream, "{");
     for (int i = 1; i < new_array->list->len; ++i) {
         jd_exp *exp = &new_array->list->args[i];
         expression_to_stream(stream, node, exp);
         if (i != new_array->list->len - 1)
-            fprintf(stream, ", ");
+            emit_str(stream, ", ");
     }
-    fprintf(stream, "}");
+    emit_str(stream, "}");
 }
@@ -88,7 +88,9 @@ string exp_operator_to_s(jd_exp *expression)
     return str_create("%s %s %s", left, op_name, right);
 }
 
-void exp_operator_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_operator_to_stream(jd_emitter *stream,
+                            jd_node *node,
+                            jd_exp *expression)
 {
     jd_exp_operator *operator   = expression->data;
     jd_exp *exp_left = &operator->list->args[0];
@@ -96,6 +98,6 @@ void exp_operator_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
     string op = get_operator_name(operator->operator);
 
     expression_to_stream(stream, node, exp_left);
-    fprintf(stream, " %s ", op);
+    emit_printf(stream, " %s ", op);
     expression_to_stream(stream, node, exp_right);
 }
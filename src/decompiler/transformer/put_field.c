@@ -10,13 +10,15 @@ string exp_put_field_to_s(jd_exp *expression)
     return str_create("%s = %s", objref_str, assigned);
 }
 
-void exp_put_field_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_put_field_to_stream(jd_emitter *stream,
+                             jd_node *node,
+                             jd_exp *expression)
 {
     jd_exp_put_field *put_field = expression->data;
     jd_exp *value_exp = &put_field->list->args[0];
     jd_exp *objref_exp = &put_field->list->args[1];
 
     expression_to_stream(stream, node, objref_exp);
-    fprintf(stream, " = ");
+    emit_str(stream, " = ");
     expression_to_stream(stream, node, value_exp);
 }
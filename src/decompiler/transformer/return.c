@@ -13,13 +13,13 @@ string exp_return_to_s(jd_exp *expression)
     }
 }
 
-void exp_return_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_return_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_return *exp_return = expression->data;
     if (exp_return->list->len == 0)
-        fprintf(stream, "return");
+        emit_str(stream, "return");
     else {
-        fprintf(stream, "return ");
+        emit_str(stream, "return ");
         expression_to_stream(stream, node, &exp_return->list->args[0]);
     }
 }
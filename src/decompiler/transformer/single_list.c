@@ -7,7 +7,7 @@ string exp_single_list_to_s(jd_exp *expression)
     return exp_to_s(first);
 }
 
-void exp_single_list_to_stream(FILE *stream,
+void exp_single_list_to_stream(jd_emitter *stream,
                                jd_node *node,
                                jd_exp *expression)
 {
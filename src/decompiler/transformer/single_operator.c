@@ -10,7 +10,7 @@ string exp_single_operator_to_s(jd_exp *expression)
 }
 
 
-void exp_single_operator_to_stream(FILE *stream,
+void exp_single_operator_to_stream(jd_emitter *stream,
                                    jd_node *node,
                                    jd_exp *expression)
 {
@@ -18,6 +18,6 @@ void exp_single_operator_to_stream(FILE *stream,
     jd_exp *exp = &single_operator->list->args[0];
     string op = get_operator_name(single_operator->operator);
 
-    fprintf(stream, "%s ", op);
+    emit_printf(stream, "%s ", op);
     expression_to_stream(stream, node, exp);
 }
@@ -6,8 +6,10 @@ string exp_stack_value_to_s(jd_exp *expression)
     return val->name;
 }
 
-void exp_stack_value_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_stack_value_to_stream(jd_emitter *stream,
+                               jd_node *node,
+                               jd_exp *expression)
 {
     jd_val *val = expression->data;
-    fprintf(stream, "%s", val->name);
+    emit_printf(stream, "%s", val->name);
 }
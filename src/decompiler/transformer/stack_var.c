@@ -6,8 +6,10 @@ string exp_stack_var_to_s(jd_exp *expression)
     return var->name;
 }
 
-void exp_stack_var_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_stack_var_to_stream(jd_emitter *stream,
+                             jd_node *node,
+                             jd_exp *expression)
 {
     jd_var *var = expression->data;
-    fprintf(stream, "%s", var->name);
+    emit_printf(stream, "%s", var->name);
 }
@@ -29,7 +29,7 @@ string exp_store_to_s(jd_exp *expression)
     }
 }
 
-void exp_store_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_store_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_store *store = expression->data;
     jd_exp *left = &store->list->args[0];
@@ -46,14 +46,14 @@ void exp_store_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
 
         string class_name = val->data->cname;
 
-        fprintf(stream, "%s ", class_name);
+        emit_printf(stream, "%s ", class_name);
         expression_to_stream(stream, node, left);
-        fprintf(stream, " = ");
+        emit_str(stream, " = ");
         expression_to_stream(stream, node, right);
     }
     else {
         expression_to_stream(stream, node, left);
-        fprintf(stream, " = ");
+        emit_str(stream, " = ");
         expression_to_stream(stream, node, right);
     }
 }
@@ -18,7 +18,9 @@ string exp_str_concat_to_s(jd_exp *expression)
     return str_join(str_list);
 }
 
-void exp_str_concat_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_str_concat_to_stream(jd_emitter *stream,
+                              jd_node *node,
+                              jd_exp *expression)
 {
     jd_exp_str_concat *str_concat = expression->data;
     jd_exp_list *list = str_concat->list;
@@ -26,7 +28,7 @@ void exp_str_concat_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
     {
         expression_to_stream(stream, node, &list->args[i]);
         if (i < list->len - 1) {
-            fprintf(stream, " + ");
+            emit_str(stream, " + ");
         }
     }
 }
@@ -7,7 +7,7 @@ string exp_switch_to_s(jd_exp *expression)
     return exp_to_s(exp);
 }
 
-void exp_switch_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_switch_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     jd_exp_switch *switch_exp = expression->data;
     jd_exp *exp = &switch_exp->list->args[0];
@@ -10,12 +10,14 @@ string exp_ternary_to_s(jd_exp *expression)
     return str_create("%s ? %s : %s", condition, true_exp, false_exp);
 }
 
-void exp_ternary_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void exp_ternary_to_stream(jd_emitter *stream,
+                           jd_node *node,
+                           jd_exp *expression)
 {
     jd_exp_ternary *ternary = expression->data;
     expression_to_stream(stream, node, &ternary->list->args[0]);
-    fprintf(stream, " ? ");
+    emit_str(stream, " ? ");
     expression_to_stream(stream, node, &ternary->list->args[1]);
-    fprintf(stream, " : ");
+    emit_str(stream, " : ");
     expression_to_stream(stream, node, &ternary->list->args[2]);
 }
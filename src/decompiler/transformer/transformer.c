@@ -120,7 +120,7 @@ string exp_to_s(jd_exp *expression)
     }
 }
 
-void expression_to_stream(FILE *stream, jd_node *node, jd_exp *expression)
+void expression_to_stream(jd_emitter *stream, jd_node *node, jd_exp *expression)
 {
     switch(expression->type) {
         case JD_EXPRESSION_INVOKE: {
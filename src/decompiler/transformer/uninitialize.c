@@ -7,11 +7,11 @@ string exp_uninitialize_to_s(jd_exp *expression)
     return str_create("alloc(%s)", val->data->cname);
 }
 
-void exp_uninitialize_to_stream(FILE *stream,
+void exp_uninitialize_to_stream(jd_emitter *stream,
                                 jd_node *node,
                                 jd_exp *expression)
 {
     jd_exp_uninitialize *uninitialize = expression->data;
     jd_val *val = uninitialize->val;
-    fprintf(stream, "alloc(%s)", val->data->cname);
+    emit_printf(stream, "alloc(%s)", val->data->cname);
 }
@@ -8,7 +8,12 @@
 #include "dex_smali.h"
 #include "analyzer/jd_analyzer.h"
 #include "ai/jd_mcp.h"
+#include "decompiler/class_filter.h"
+#include "decompiler/profiler.h"
+#include "decompiler/method_budget.h"
+#include "decompiler/schedule.h"
 #include <unistd.h>
+#include <getopt.h>
 
 typedef enum {
     JD_FILE_TYPE_UNKNOWN = 0,
@@ -122,15 +127,45 @@ static void prepare_opt_threads(jd_opt *opt) {
 }
 
 static void opt_usage(const char *progname) {
-    fprintf(stderr, "Usage: %s file [-p] [-o outpath] [-t num] [-g] [-s]\n", progname);
+    fprintf(stderr, "Usage: %s file [-p] [-o outpath] [-t num] [-g] [-s] "
+                    "[-i pattern] [-x pattern] [--profile] "
+                    "[--max-ins n] [--max-blocks n] [--max-iterations n] "
+                    "[--max-ms n] [--lpt]\n", progname);
     fprintf(stderr, "    -p: like javap or dexdump, print class info\n");
     fprintf(stderr, "    -o: output path for jar/dex/war files\n");
     fprintf(stderr, "    -t: number of threads to use (default is 4)\n");
     fprintf(stderr, "    -g: generate call graph for dex/apk\n");
     fprintf(stderr, "    -s: apk/dex to smali\n");
+    fprintf(stderr, "    -i: only classes matching the pattern, repeatable\n"
+                    "        package/class prefix (com.foo) or glob "
+                    "(com.foo.*Activity, com.**.internal.*)\n");
+    fprintf(stderr, "    -x: skip classes matching the pattern, repeatable\n");
     fprintf(stderr, "    -m: start MCP server (stdio protocol)\n");
+    fprintf(stderr, "    --profile: time and allocation of every pass per "
+                    "method/class,\n"
+                    "        saved to garlic_profile.json and "
+                    "garlic_profile_methods.csv\n");
+    fprintf(stderr, "    --max-ins, --max-blocks, --max-iterations, "
+                    "--max-ms: per method budget\n"
+                    "        of instructions, basic blocks, optimize "
+                    "iterations and wall time,\n"
+                    "        a method over it is written as bytecode "
+                    "comments (default unlimited)\n");
+    fprintf(stderr, "    --lpt: decompile the largest classes first, "
+                    "estimated vs actual\n"
+                    "        cost saved to garlic_schedule.csv\n");
 }
 
+static const struct option long_opts[] = {
+    {"profile",         no_argument,        NULL, 'P'},
+    {"max-ins",         required_argument,  NULL, 'I'},
+    {"max-blocks",      required_argument,  NULL, 'B'},
+    {"max-iterations",  required_argument,  NULL, 'R'},
+    {"max-ms",          required_argument,  NULL, 'T'},
+    {"lpt",             no_argument,        NULL, 'L'},
+    {NULL,              0,                  NULL, 0},
+};
+
 static jd_opt* parse_opt(int argc, char **argv) {
     int oc;
     optind = 2;
@@ -150,7 +185,8 @@ static jd_opt* parse_opt(int argc, char **argv) {
     opt->path = path;
     opt->ft = ft;
 
-    while ((oc = getopt(argc, argv, "spo:t:ghm")) != -1) {
+    while ((oc = getopt_long(argc, argv, "spo:t:ghmi:x:",
+                             long_opts, NULL)) != -1) {
         switch (oc) {
             case 'p': { // like javap
                 opt->option = JD_FILE_OPTION_DUMP;
@@ -179,6 +215,38 @@ static jd_opt* parse_opt(int argc, char **argv) {
                 opt->thread_num = atoi(optarg);
                 break;
             }
+            case 'i': {
+                class_filter_include(optarg);
+                break;
+            }
+            case 'x': {
+                class_filter_exclude(optarg);
+                break;
+            }
+            case 'P': {
+                profiler_enable();
+                break;
+            }
+            case 'I': {
+                g_method_budget.instructions = atoi(optarg);
+                break;
+            }
+            case 'B': {
+                g_method_budget.blocks = atoi(optarg);
+                break;
+            }
+            case 'R': {
+                g_method_budget.iterations = atoi(optarg);
+                break;
+            }
+            case 'T': {
+                g_method_budget.ms = atoi(optarg);
+                break;
+            }
+            case 'L': {
+                schedule_lpt_enable();
+                break;
+            }
             case '?': {
                 if (optopt == 'o') {
                     fprintf(stderr, "[garlic] Option -%c requires a output path.\n", optopt);
@@ -189,6 +257,10 @@ static jd_opt* parse_opt(int argc, char **argv) {
                                     "level directory as the file\n"
                                     "    class's will be output to stdout\n");
                 }
+                else if (optopt == 'i' || optopt == 'x') {
+                    fprintf(stderr, "[garlic] Option -%c requires a class pattern.\n", optopt);
+                    fprintf(stderr, "    example: %s %s -%c com.example.ui\n", argv[0], path, optopt);
+                }
                 else if (optopt == 't' && !is_jvm_class(opt)) {
                     fprintf(stderr, "[garlic] Option -%c requires a number of threads count.\n", optopt);
                     fprintf(stderr, "    example: %s %s -t [thread count]\n", argv[0], path);
@@ -208,6 +280,12 @@ static jd_opt* parse_opt(int argc, char **argv) {
     return opt;
 }
 
+static void report_profile(jd_opt *opt) {
+    // a single class prints to stdout, its report goes to the cwd
+    profiler_report(opt->out != NULL ? opt->out : ".");
+    schedule_report(opt->out != NULL ? opt->out : ".");
+}
+
 static void free_opt(jd_opt *opt) {
     if (opt->out != NULL) {
         free(opt->out);
@@ -329,18 +407,22 @@ int main(int argc, char **argv)
 
     if (is_jvm_class(opt)) {
         run_for_jvm_class(opt);
+        report_profile(opt);
         free_opt(opt);
     }
     else if (is_jar_file(opt)) {
         run_for_jvm_jar(opt);
+        report_profile(opt);
         free_opt(opt);
     }
     else if (is_dex_file(opt)) {
         run_for_dex(opt);
+        report_profile(opt);
         free_opt(opt);
     }
     else if (is_apk_file(opt)) {
         run_for_apk(opt);
+        report_profile(opt);
         free_opt(opt);
     }
     else {
@@ -7,17 +7,23 @@
 #include "decompiler/expression_writter.h"
 #include "common/file_tools.h"
 #include "libs/threadpool/threadpool.h"
+#include "decompiler/class_filter.h"
+#include "decompiler/schedule.h"
 
 static int jar_progress_len = 0;
+static pthread_mutex_t jar_progress_lock = PTHREAD_MUTEX_INITIALIZER;
 
 void jar_status(jd_jar *jar)
 {
-    pthread_mutex_lock(jar->threadpool->lock);
-    jar->done++;
+    __atomic_add_fetch(&jar->done, 1, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&jar_progress_lock);
     for (int i = 0; i < jar_progress_len; i++) putchar('\b');
-    jar_progress_len = printf("Progress : %d (%d)", jar->done, jar->added);
+    jar_progress_len = printf("Progress : %d (%d)",
+                              __atomic_load_n(&jar->done, __ATOMIC_RELAXED),
+                              jar->added);
     fflush(stdout);
-    pthread_mutex_unlock(jar->threadpool->lock);
+    pthread_mutex_unlock(&jar_progress_lock);
 }
 
 void jar_main_thread_status(jd_jar *jar)
@@ -76,6 +82,10 @@ static string jar_entry_parent_path(jd_jar *jar, jd_jar_entry *entry)
     return parent_full;
 }
 
+/**
+ * only walk the central directory here, names and sizes are enough to
+ * link inner/anonymous classes, the workers inflate the entries later
+ **/
 static void prepare_jar_zip(jd_jar *jar)
 {
     struct zip_t *zip = zip_open(jar->path, 0, 'r');
@@ -86,11 +96,11 @@ static void prepare_jar_zip(jd_jar *jar)
     for (int i = 0; i < jar->entries_size; ++i) {
         zip_entry_openbyindex(zip, i);
         string path_in_jar = (string)zip_entry_name(zip);
-        string full_path = str_create_in(jar->pool, "%s", path_in_jar);
         if (!str_end_with(path_in_jar, ".class")) {
             zip_entry_close(zip); // only deal with .class files
             continue;
         }
+        string full_path = str_create_in(jar->pool, "%s", path_in_jar);
         string cname = jar_cname_from_path(jar, path_in_jar);
         DEBUG_PRINT("[process file at]: %s %s\n", path_in_jar, cname);
 
@@ -103,16 +113,10 @@ static void prepare_jar_zip(jd_jar *jar)
         entry->inner_classes = linit_object_with_pool(jar->pool);
         entry->anoymous_classes = linit_object_with_pool(jar->pool);
         entry->jar = jar;
-
-        char *buf = NULL;
-        size_t buf_size;
-        buf_size = zip_entry_size(zip);
-        buf = x_alloc_in(jar->pool, buf_size * sizeof(unsigned char));
-        zip_entry_noallocread(zip, (void *)buf, buf_size);
+        entry->buf = NULL;
+        entry->buf_size = zip_entry_size(zip);
         zip_entry_close(zip);
 
-        entry->buf = buf;
-        entry->buf_size = buf_size;
         ladd_obj(jar->class_entries, entry);
 
         hset_s2o(jar->name_to_index_map, full_path, entry);
@@ -120,6 +124,35 @@ static void prepare_jar_zip(jd_jar *jar)
     }
 }
 
+static struct zip_t* jar_thread_zip(jd_jar *jar)
+{
+    thread_local_data *tls = get_thread_local_data();
+    int slot = tls == NULL ? 0 : tls->thread_id + 1;
+    if (slot >= jar->zips_size)
+        return jar->zip;
+    // miniz readers are not thread safe, every worker opens its own
+    if (jar->zips[slot] == NULL)
+        jar->zips[slot] = zip_open(jar->path, 0, 'r');
+    return jar->zips[slot];
+}
+
+/**
+ * inflate the entry into the current pool, the bytes go away with the
+ * task's arena once the class is written
+ **/
+static void jar_entry_inflate(jd_jar_entry *entry)
+{
+    struct zip_t *zip = jar_thread_zip(entry->jar);
+    zip_entry_openbyindex(zip, entry->index);
+    size_t buf_size = zip_entry_size(zip);
+    char *buf = x_alloc_raw(buf_size);
+    zip_entry_noallocread(zip, (void *)buf, buf_size);
+    zip_entry_close(zip);
+
+    entry->buf = buf;
+    entry->buf_size = buf_size;
+}
+
 static void jar_inner_and_anoymous_class(jd_jar *jar)
 {
     for (int i = 0; i < jar->class_entries->size; ++i) {
@@ -177,11 +210,16 @@ static jd_jar* jar_obj_create(string path, string save_path, int thread_cnt)
     jar->anoymous_class_map = hashmap_init_in(jar->pool, s2o_cmp, 0);
     jar->name_to_index_map = hashmap_init_in(jar->pool, s2o_cmp, 0);
     jar->index_to_name_map = hashmap_init_in(jar->pool, i2obj_cmp, 0);
+    jar->intern = intern_create(jar->pool);
 
     mkdir_p(jar->save);
 
     prepare_jar_zip(jar);
 
+    jar->zips_size = thread_cnt + 1;
+    jar->zips = make_obj_arr_in(struct zip_t*, jar->zips_size, jar->pool);
+    jar->zips[0] = jar->zip;
+
     if (thread_cnt > 1) {
         jar->threadpool = threadpool_create_in(jar->pool, thread_cnt, 0);
     }
@@ -195,6 +233,10 @@ static void jar_obj_release(jd_jar *jar)
 {
     if (jar->threadpool)
         threadpool_destroy(jar->threadpool, 1);
+    for (int i = 1; i < jar->zips_size; ++i) {
+        if (jar->zips[i] != NULL)
+            zip_close(jar->zips[i]);
+    }
     zip_close(jar->zip);
     mem_pool_free(jar->pool);
 }
@@ -202,33 +244,80 @@ static void jar_obj_release(jd_jar *jar)
 void jar_entry_thread_task(jd_jar_entry *entry)
 {
     thread_local_data *tls = get_thread_local_data();
-    tls->pool = mem_create_pool();
+    tls->pool = tls->arena;
 
     jsource_file *jf = jar_entry_analyse(entry->jar, entry, NULL);
     if (jf->parent == NULL) {
         writter_for_class(jf, NULL);
         fclose(jf->source);
     }
-    mem_pool_free(tls->pool);
+    mem_pool_clear(tls->pool);
 
     jar_status(entry->jar);
 }
 
+static bool jar_entry_nested_selected(jd_jar_entry *entry)
+{
+    list_object *lists[2] = {entry->inner_classes, entry->anoymous_classes};
+    for (int k = 0; k < 2; ++k) {
+        for (int i = 0; i < lists[k]->size; ++i) {
+            jd_jar_entry *nested = lget_obj(lists[k], i);
+            if (class_filter_match_nested(nested->path) ||
+                jar_entry_nested_selected(nested))
+                return true;
+        }
+    }
+    return false;
+}
+
+static bool jar_entry_selected(jd_jar_entry *entry)
+{
+    return class_filter_match(entry->path) ||
+           jar_entry_nested_selected(entry);
+}
+
+/**
+ * estimate of the class task for --lpt, the class file sizes of the
+ * entry and of the nested classes decompiled inside its task. the code
+ * attributes are only known after inflating, the file size is already
+ * in the central directory
+ **/
+static u8 jar_entry_cost(jd_jar_entry *entry)
+{
+    u8 cost = SCHEDULE_CLASS_COST + entry->buf_size;
+    list_object *lists[2] = {entry->inner_classes, entry->anoymous_classes};
+    for (int k = 0; k < 2; ++k) {
+        for (int i = 0; i < lists[k]->size; ++i)
+            cost += jar_entry_cost(lget_obj(lists[k], i));
+    }
+    return cost;
+}
+
 static void jar_threadpool_start(jd_jar *jar)
 {
+    jd_schedule schedule;
+    schedule_init(&schedule, jar->threadpool);
     for (int i = 0; i < jar->class_entries->size; ++i) {
         jd_jar_entry *entry = lget_obj(jar->class_entries, i);
         if (entry->is_inner || entry->is_anoymous)
             continue;
-        threadpool_add(jar->threadpool, &jar_entry_thread_task, entry, 0);
+        if (!jar_entry_selected(entry))
+            continue;
+        schedule_add(&schedule,
+                     &jar_entry_thread_task,
+                     entry,
+                     entry->path,
+                     g_schedule_lpt ? jar_entry_cost(entry) : 0);
         jar->added++;
     }
+    schedule_submit(&schedule);
 }
 
 jsource_file* jar_entry_anonymous_analyse(jd_jar *jar,
                                         jd_jar_entry *entry,
                                         jsource_file *parent)
 {
+        jar_entry_inflate(entry);
         jclass_file *jc = parse_class_content_from_jar_entry(entry);
         jsource_file *jf = jc->jfile;
         jf->jar = jar;
@@ -248,6 +337,8 @@ jsource_file* jar_entry_analyse(jd_jar *jar,
                                 jd_jar_entry *entry,
                                 jsource_file *parent)
 {
+    jd_intern *previous = intern_scope_enter(jar->intern);
+    jar_entry_inflate(entry);
     jclass_file *jc = parse_class_content_from_jar_entry(entry);
     jsource_file *jf = jc->jfile;
     jf->jar = jar;
@@ -283,6 +374,7 @@ jsource_file* jar_entry_analyse(jd_jar *jar,
         inner_block->parent = parent_body;
         ladd_obj(parent_body->children, inner_block);
     }
+    intern_scope_leave(previous);
     return jc->jfile;
 }
 
@@ -299,6 +391,8 @@ static void jar_main_thread(jd_jar *jar)
 
         if (entry->is_inner || entry->is_anoymous)
             continue;
+        if (!jar_entry_selected(entry))
+            continue;
 
         mem_init_pool();
 
@@ -67,6 +67,7 @@ void jvm_init_method_fn(jsource_file *jf)
     fn->is_varargs = jvm_method_is_varargs;
     fn->is_synthetic = jvm_method_is_synthetic;
     fn->is_member = jvm_method_is_member;
+    fn->bytecode_fn = jvm_method_bytecode;
     jf->method_fn = fn;
 }
 
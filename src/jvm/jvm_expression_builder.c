@@ -1393,7 +1393,11 @@ static void follow_lambda(jd_method *m, jd_exp *exp)
             ladd_obj(jc->jfile->methods, target_method);
 
             jvm_method(m->meta, target_method, jm);
-            build_lambda_expression(exp, lambda, target_method);
+            // a body cut off by the budget is referenced by name
+            if (method_is_truncated(target_method))
+                build_lambda_expression(exp, lambda, NULL);
+            else
+                build_lambda_expression(exp, lambda, target_method);
             method_mark_lambda(target_method);
             in_current_class = 1;
         }
@@ -11,6 +11,9 @@
 #include "jvm/jvm_exception.h"
 #include "jvm/jvm_annotation.h"
 #include "jvm/jvm_descriptor.h"
+#include "decompiler/profiler.h"
+#include "decompiler/method_budget.h"
+#include "parser/class/metadata.h"
 
 void jvm_method_access_flags(jd_method *m, str_list *list) {
     if (method_has_flag(m, METHOD_ACC_FINAL))
@@ -63,6 +66,14 @@ void jvm_method_access_flags(jd_method *m, str_list *list) {
             str_concat(list, (" "));
 }
 
+void jvm_method_bytecode(jd_method *m, FILE *stream)
+{
+    jmethod *jm = m->meta_method;
+    if (jm->code_attribute == NULL)
+        return;
+    print_code_section(m->meta, jm->code_attribute, stream);
+}
+
 jd_val* jvm_method_parameter_val(jd_method *m, int index)
 {
     if (m->enter == NULL)
@@ -134,8 +145,7 @@ static void init_tableswitch_jumps(jd_ins *ins) {
     p12 = ins->param[padding + 11];
 
     uint32_t default_offset = be_32(p1, p2, p3, p4) + ins->offset;
-    int default_idx = hget_i2i(ins->method->offset2id_map,
-                               default_offset);
+    int default_idx = ins_idx_of_offset(ins->method, default_offset);
 
     jd_ins *default_ins = get_ins(ins->method, default_idx);
     if (!lcontains_obj(ins->targets, default_ins))
@@ -166,7 +176,6 @@ static void init_lookupswitch_jumps(jd_ins *ins)
 {
     u1 p1, p2, p3, p4, p5, p6, p7, p8;
     uint32_t padding = jvm_switch_padding(ins->offset);
-    hashmap *map = ins->method->offset2id_map;
     p1 = ins->param[padding + 0];
     p2 = ins->param[padding + 1];
     p3 = ins->param[padding + 2];
@@ -177,7 +186,7 @@ static void init_lookupswitch_jumps(jd_ins *ins)
     p8 = ins->param[padding + 7];
     uint32_t default_offset = be_32(p1, p2, p3, p4) + ins->offset;
 
-    int default_idx = hget_i2i(map, default_offset);
+    int default_idx = ins_idx_of_offset(ins->method, default_offset);
 
     jd_ins *default_ins = get_ins(ins->method, default_idx);
     ladd_obj_no_dup(ins->targets, default_ins);
@@ -232,7 +241,7 @@ static void init_unconditional_jumps(jd_ins *ins)
     }
 
     uint32_t jump_offset = jump_byte + ins->offset;
-    int target_id = hget_i2i(ins->method->offset2id_map, jump_offset);
+    int target_id = ins_idx_of_offset(ins->method, jump_offset);
     jd_ins *target_ins = get_ins(ins->method, target_id);
     ladd_obj(ins->targets, target_ins);
     ladd_obj(ins->jumps, target_ins);
@@ -242,7 +251,7 @@ static void init_default_jumps(jd_ins *ins)
 {
     if (jvm_ins_is_return(ins) || jvm_ins_is_athrow(ins)) return;
     uint32_t next_offset = ins->offset + ins->param_length + 1;
-    int idx = hget_i2i(ins->method->offset2id_map, next_offset);
+    int idx = ins_idx_of_offset(ins->method, next_offset);
 
     jd_ins *target_ins = get_ins(ins->method, idx);
     ladd_obj(ins->targets, target_ins);
@@ -288,31 +297,27 @@ uint32_t caculate_param_length(jd_method *m, uint32_t i)
     }
 }
 
-static int method_instruction_count(jd_method *m)
-{
-    int result = 0;
-    for (uint32_t i = 0; i < be32toh(m->code_length); ) {
-        uint32_t param_length = caculate_param_length(m, i);
-        i += param_length + 1;
-        result ++;
-    }
-    return result;
-}
-
+/**
+ * the instructions are counted first, then built in one contiguous
+ * array, prev/next neighbours are adjacent in memory
+ **/
 static void init_method_instructions(jd_method *m)
 {
     jclass_file *jc = m->meta;
     jsource_file *jf = jc->jfile;
-    int ins_count = method_instruction_count(m);
-    m->instructions = linit_object_with_capacity(ins_count);
-    m->offset2id_map = hashmap_init((hcmp_fn) i2i_cmp, ins_count);
+    uint32_t code_length = be32toh(m->code_length);
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < code_length; ++size)
+        i += caculate_param_length(m, i) + 1;
+
+    jd_ins *arr = make_obj_arr(jd_ins, size);
+    m->instructions = linit_object_with_capacity(size);
 
-    int idx = 0;
-    jd_ins *prev_ins = NULL;
-    for (uint32_t i = 0; i < be32toh(m->code_length); ) {
+    uint32_t i = 0;
+    for (uint32_t k = 0; k < size; ++k) {
         u1 opcode = m->code[i];
         uint32_t param_length = caculate_param_length(m, i);
-        jd_ins *ins = make_obj(jd_ins);
+        jd_ins *ins = &arr[k];
         ins->method = m;
         ins->code = opcode;
         ins->name = get_opcode_name(m->meta, opcode);
@@ -364,9 +369,9 @@ static void init_method_instructions(jd_method *m)
         ins->idx = m->instructions->size;
         ins->offset = i;
 
-        ins->targets = linit_object_with_capacity(1);
-        ins->jumps = linit_object_with_capacity(2);
-        ins->comings = linit_object_with_capacity(1);
+        ins->targets = linit_obj_small();
+        ins->jumps = linit_obj_small();
+        ins->comings = linit_obj_small();
 
         if (jvm_ins_is_store(ins)) {
             ins->defs = bitset_create();
@@ -380,19 +385,13 @@ static void init_method_instructions(jd_method *m)
             bitset_set(ins->uses, slot);
         }
 
-        if (prev_ins == NULL) {
-            ins->prev = NULL;
-        }
-        else {
-            ins->prev = prev_ins;
-            prev_ins->next = ins;
+        if (k > 0) {
+            ins->prev = &arr[k - 1];
+            arr[k - 1].next = ins;
         }
-        hset_i2i(m->offset2id_map, ins->offset, ins->idx);
         ladd_obj(m->instructions, ins);
-        prev_ins = ins;
         ins->param_length = param_length;
         i += param_length + 1;
-        idx++;
     }
 
 }
@@ -405,7 +404,6 @@ static void init_method_exception_table(jd_method *m, jmethod *item)
         return;
     int _length = be16toh(code_attr->exception_table_length);
     m->cfg_exceptions = linit_object();
-    hashmap *offset2id_map = m->offset2id_map;
     for (int i = 0; i < _length; ++i) {
         jattr_code_exception_table *eitem = &code_attr->exception_table[i];
         jd_exc *e = make_obj(jd_exc);
@@ -417,15 +415,15 @@ static void init_method_exception_table(jd_method *m, jmethod *item)
 
         e->try_start = be16toh(eitem->start_pc);
         int try_end_offset = be16toh(eitem->end_pc);
-        int try_end_idx = hget_i2i(offset2id_map, try_end_offset);
+        int try_end_idx = ins_idx_of_offset(m, try_end_offset);
         int prev_try_end_idx = try_end_idx - 1;
         jd_ins *prev_try_end_ins = get_ins(m, prev_try_end_idx);
         e->try_end = prev_try_end_ins->offset;
         e->try_end_idx = prev_try_end_ins->idx;
         e->handler_start = be16toh(eitem->handler_pc);
         e->catch_type_index = be16toh(eitem->catch_type);
-        e->try_start_idx = hget_i2i(offset2id_map, e->try_start);
-        e->handler_start_idx = hget_i2i(offset2id_map, e->handler_start);
+        e->try_start_idx = ins_idx_of_offset(m, e->try_start);
+        e->handler_start_idx = ins_idx_of_offset(m, e->handler_start);
 
         ladd_obj(m->cfg_exceptions, e);
     }
@@ -492,20 +490,35 @@ void jvm_method_init(jclass_file *jc, jd_method *m, jmethod *item)
     init_method_exception_table(m, item);
 }
 
-void jvm_method(jclass_file *jc, jd_method *m, jmethod *jm)
+static void jvm_method_decompile(jclass_file *jc, jd_method *m, jmethod *jm)
 {
     jvm_method_init(jc, m, jm);
 
     if (method_is_unsupport(m) || method_is_empty(m))
         return;
 
-    jvm_rename_goto2return(m);
+    if (method_budget_exceeded(m))
+        return;
+
+    PROFILE_PASS(m, jvm_rename_goto2return);
+
+    PROFILE_PASS(m, jvm_method_exception_edge);
+
+    if (method_budget_exceeded(m))
+        return;
 
-    jvm_method_exception_edge(m);
+    PROFILE_PASS(m, jvm_simulator);
 
-    jvm_simulator(m);
+    PROFILE_PASS(m, cfg_remove_exception_block);
 
-    cfg_remove_exception_block(m);
+    if (method_budget_exceeded(m))
+        return;
 
     optimize_jvm_method(m);
 }
+
+void jvm_method(jclass_file *jc, jd_method *m, jmethod *jm)
+{
+    method_budget_begin(m);
+    PROFILE_METHOD(m, jvm_method_decompile(jc, m, jm));
+}
@@ -8,6 +8,8 @@ jd_val* jvm_method_parameter_val(jd_method *m, int index);
 
 void jvm_method_access_flags(jd_method *m, str_list *list);
 
+void jvm_method_bytecode(jd_method *m, FILE *stream);
+
 void jvm_method_init(jclass_file *jc, jd_method *m, jmethod *item);
 
 void jvm_method(jclass_file *jc, jd_method *m, jmethod *jm);
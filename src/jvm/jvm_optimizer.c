@@ -28,89 +28,119 @@
 #include "decompiler/expression_assert.h"
 #include "decompiler/expression_copy_propgation.h"
 #include "decompiler/expression_exception.h"
+#include "decompiler/profiler.h"
+#include "decompiler/pass_manager.h"
+#include "decompiler/method_budget.h"
 
 static void init_method_data(jd_method *m)
 {
     m->declarations = bitset_create();
 }
 
+static const jd_fixpoint_pass jvm_fixpoint_passes[] = {
+    FIXPOINT_PASS(identify_logical_operations,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP | JD_CHANGE_CONDITION,
+                  JD_CHANGE_CONTROL | JD_CHANGE_CONDITION),
+    FIXPOINT_PASS(identify_reverse_logical_operation,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP | JD_CHANGE_CONDITION,
+                  JD_CHANGE_CONTROL | JD_CHANGE_CONDITION),
+    FIXPOINT_PASS(identify_initialize,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT),
+    FIXPOINT_PASS(identify_ternary_operator,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP | JD_CHANGE_VALUE,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP | JD_CHANGE_VALUE |
+                  JD_CHANGE_COUNT),
+    FIXPOINT_PASS(identify_assignment_chain,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT),
+    FIXPOINT_PASS(identify_define_stack_variable_chain,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT |
+                  JD_CHANGE_CHAIN),
+    FIXPOINT_PASS(identify_assignment_chain_store,
+                  JD_CHANGE_VALUE | JD_CHANGE_CHAIN,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT |
+                  JD_CHANGE_CHAIN),
+    FIXPOINT_PASS(identify_logical_with_assignment,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP | JD_CHANGE_CONDITION |
+                  JD_CHANGE_VALUE,
+                  JD_CHANGE_NOP | JD_CHANGE_CONDITION),
+    FIXPOINT_PASS(identify_ternary_operator_in_condition,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP,
+                  JD_CHANGE_CONTROL | JD_CHANGE_CONDITION),
+    FIXPOINT_PASS(identify_array_initialize,
+                  JD_CHANGE_CONTROL | JD_CHANGE_NOP | JD_CHANGE_VALUE,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT),
+    // conditions only move between ifs in the other passes, their stack
+    // variables stay the same, and a nopped expression is never a use
+    FIXPOINT_PASS(inline_variables,
+                  JD_CHANGE_VALUE | JD_CHANGE_COUNT,
+                  JD_CHANGE_NOP | JD_CHANGE_VALUE | JD_CHANGE_COUNT |
+                  JD_CHANGE_CONDITION),
+};
+
 void optimize_jvm_method(jd_method *m)
 {
     if (method_is_empty(m))
         return;
 
-    instruction_to_expression(m);
-
-    init_method_data(m);
-
-    jvm_fix_type(m);
-
-    negative_if_expression(m);
-
-    nop_empty_expression(m);
-
-    inline_variables(m);
-
-    identify_cmp_after_if(m);
+    PROFILE_PASS(m, instruction_to_expression);
 
-    optimize_enum_constructor(m);
+    PROFILE_PASS(m, init_method_data);
 
-    create_node_tree(m);
+    PROFILE_PASS(m, jvm_fix_type);
 
-    bool changed = false;
+    PROFILE_PASS(m, negative_if_expression);
 
-    do {
-        changed = identify_logical_operations(m);
+    PROFILE_PASS(m, nop_empty_expression);
 
-        changed |= identify_reverse_logical_operation(m);
+    PROFILE_PASS(m, inline_variables);
 
-        changed |= identify_initialize(m);
+    PROFILE_PASS(m, identify_cmp_after_if);
 
-        changed |= identify_ternary_operator(m);
+    PROFILE_PASS(m, optimize_enum_constructor);
 
-        changed |= identify_assignment_chain(m);
+    PROFILE_PASS(m, create_node_tree);
 
-        changed |= identify_define_stack_variable_chain(m);
-
-        changed |= identify_assignment_chain_store(m);
-
-        changed |= identify_logical_with_assignment(m);
-
-        changed |= identify_ternary_operator_in_condition(m);
-
-        changed |= identify_array_initialize(m);
+    if (method_budget_exceeded(m))
+        return;
 
-        changed |= inline_variables(m);
+    run_fixpoint_passes(m,
+                        jvm_fixpoint_passes,
+                        sizeof(jvm_fixpoint_passes) /
+                        sizeof(jvm_fixpoint_passes[0]));
 
-    } while (changed);
+    if (method_budget_exceeded(m))
+        return;
 
-    inline_variables_round2(m);
+    PROFILE_PASS(m, inline_variables_round2);
 
-    identify_assignment(m);
+    PROFILE_PASS(m, identify_assignment);
 
-    identify_loop(m);
+    PROFILE_PASS(m, identify_loop);
 
-    identify_branches(m);
+    PROFILE_PASS(m, identify_branches);
 
-    identify_if_break_or_if_continue(m);
+    PROFILE_PASS(m, identify_if_break_or_if_continue);
 
-    identify_synchronized(m);
+    PROFILE_PASS(m, identify_synchronized);
 
-    optimize_goto_expression(m);
+    PROFILE_PASS(m, optimize_goto_expression);
 
-    analyse_local_variables(m);
+    PROFILE_PASS(m, analyse_local_variables);
 
-    copy_propagation_of_dup_local_variable(m);
+    PROFILE_PASS(m, copy_propagation_of_dup_local_variable);
 
-    identify_loop_type(m);
+    PROFILE_PASS(m, identify_loop_type);
 
-    remove_empty_if_else_of_method(m);
+    PROFILE_PASS(m, remove_empty_if_else_of_method);
 
-    nop_node_last_return(m);
+    PROFILE_PASS(m, nop_node_last_return);
 
-    setup_expression_node_param(m);
+    PROFILE_PASS(m, setup_expression_node_param);
 
-    optimize_exception_block(m);
+    PROFILE_PASS(m, optimize_exception_block);
 }
 
 
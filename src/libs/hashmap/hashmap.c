@@ -1,162 +1,147 @@
-/*
- * 	this code is copy form https://github.com/git/git/blob/master/hashmap.c
- */
-
 #include "hashmap.h"
 #include "mem_pool.h"
 
-#define FNV32_BASE ((unsigned int) 0x811c9dc5)
-#define FNV32_PRIME ((unsigned int) 0x01000193)
+/**
+ * wyhash: 8 bytes per read, a 64x64->128 multiply folds them in
+ **/
+#define WY_P0 0xa0761d6478bd642full
+#define WY_P1 0xe7037ed1a0b428dbull
+#define WY_P2 0x8ebc6af09c88c6e3ull
+#define WY_P3 0x589965cc75374cc3ull
 
-unsigned int strhash(const char *str)
+static inline uint64_t wy_r8(const uint8_t *p)
 {
-	unsigned int c, hash = FNV32_BASE;
-	while ((c = (unsigned char) *str++))
-		hash = (hash * FNV32_PRIME) ^ c;
-	return hash;
-}
-
-unsigned int strihash(const char *str)
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t wy_r4(const uint8_t *p)
 {
-	unsigned int c, hash = FNV32_BASE;
-	while ((c = (unsigned char) *str++)) {
-		if (c >= 'a' && c <= 'z')
-			c -= 'a' - 'A';
-		hash = (hash * FNV32_PRIME) ^ c;
-	}
-	return hash;
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
 }
 
-unsigned int memhash(const void *buf, size_t len)
+static inline uint64_t wy_r3(const uint8_t *p, size_t k)
 {
-	unsigned int hash = FNV32_BASE;
-	unsigned char *ucbuf = (unsigned char *) buf;
-	while (len--) {
-		unsigned int c = *ucbuf++;
-		hash = (hash * FNV32_PRIME) ^ c;
-	}
-	return hash;
+    return (((uint64_t)p[0]) << 16) | (((uint64_t)p[k >> 1]) << 8) | p[k - 1];
 }
-
-unsigned int memihash(const void *buf, size_t len)
-{
-	unsigned int hash = FNV32_BASE;
-	unsigned char *ucbuf = (unsigned char *) buf;
-	while (len--) {
-		unsigned int c = *ucbuf++;
-		if (c >= 'a' && c <= 'z')
-			c -= 'a' - 'A';
-		hash = (hash * FNV32_PRIME) ^ c;
-	}
-	return hash;
+
+uint64_t hash_bytes(const void *buf, size_t len)
+{
+    const uint8_t *p = buf;
+    uint64_t seed = hash_mix(WY_P0, WY_P1);
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t off = (len >> 3) << 2;
+            a = (wy_r4(p) << 32) | wy_r4(p + off);
+            b = (wy_r4(p + len - 4) << 32) | wy_r4(p + len - 4 - off);
+        }
+        else if (len > 0) {
+            a = wy_r3(p, len);
+            b = 0;
+        }
+        else {
+            a = 0;
+            b = 0;
+        }
+    }
+    else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+            do {
+                seed = hash_mix(wy_r8(p) ^ WY_P1, wy_r8(p + 8) ^ seed);
+                see1 = hash_mix(wy_r8(p + 16) ^ WY_P2, wy_r8(p + 24) ^ see1);
+                see2 = hash_mix(wy_r8(p + 32) ^ WY_P3, wy_r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = hash_mix(wy_r8(p) ^ WY_P1, wy_r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wy_r8(p + i - 16);
+        b = wy_r8(p + i - 8);
+    }
+    __uint128_t r = (__uint128_t)(a ^ WY_P1) * (b ^ seed);
+    return hash_mix((uint64_t)r ^ WY_P0 ^ len, (uint64_t)(r >> 64) ^ WY_P1);
 }
 
-/*
- * Incoporate another chunk of data into a memihash
- * computation.
- */
-unsigned int memihash_cont(unsigned int seed, const void *buf, size_t len)
+static inline unsigned int growth_limit(unsigned int capacity)
 {
-	unsigned int hash = seed;
-	unsigned char *ucbuf = (unsigned char *) buf;
-	while (len--) {
-		unsigned int c = *ucbuf++;
-		if (c >= 'a' && c <= 'z')
-			c -= 'a' - 'A';
-		hash = (hash * FNV32_PRIME) ^ c;
-	}
-	return hash;
+    return capacity - capacity / 8;
 }
 
-#define HASHMAP_INITIAL_SIZE 256
-/* grow / shrink by 2^2 */
-#define HASHMAP_RESIZE_BITS 2
-/* load factor in percent */
-#define HASHMAP_LOAD_FACTOR 80
-
-static void alloc_table(struct hashmap *map, unsigned int size)
+static void* hashmap_alloc(struct hashmap *map, size_t size)
 {
-	map->tablesize = size;
-    if (map->pool == NULL)
-        map->table = x_alloc(size * sizeof(struct hashmap_entry *));
-    else
-        map->table = x_alloc_in(map->pool, size * sizeof(struct hashmap_entry *));
-
-	/* calculate resize thresholds for new size */
-	map->grow_at = (unsigned int) ((uint64_t) size*HASHMAP_LOAD_FACTOR / 100);
-	if (size <= HASHMAP_INITIAL_SIZE) {
-		map->shrink_at = 0;
-	}
-	else {
-		/*
-		 * The shrink-threshold must be slightly smaller than
-		 * (grow-threshold / resize-factor) to prevent erratic resizing,
-		 * thus we divide by (resize-factor + 1).
-		 */
-		map->shrink_at = map->grow_at / ((1 << HASHMAP_RESIZE_BITS) + 1);
-	}
+    return map->pool == NULL ? x_alloc(size) : x_alloc_in(map->pool, size);
 }
 
-static inline int entry_equals(const struct hashmap *map,
-		const struct hashmap_entry *e1, const struct hashmap_entry *e2,
-		const void *keydata)
+// the first HASHMAP_GROUP bytes are mirrored after the table
+static inline void set_ctrl(struct hashmap *map, size_t i, int8_t h)
 {
-	return (e1 == e2) ||
-        (e1->hash == e2->hash &&
-        !map->cmpfn(e1, e2, keydata));
+    map->ctrl[i] = h;
+    if (i < HASHMAP_GROUP)
+        map->ctrl[map->capacity + i] = h;
 }
 
-static inline unsigned int bucket(const struct hashmap *map,
-		const struct hashmap_entry *key)
+static size_t find_free_slot(const struct hashmap *map, uint64_t hash)
 {
-	return key->hash & (map->tablesize - 1);
+    size_t mask = map->capacity - 1;
+    size_t pos = (hash >> 7) & mask;
+    size_t step = 0;
+    for (;;) {
+        hmask m = hgroup_match_free(hgroup_load(map->ctrl + pos));
+        if (m != 0)
+            return (pos + hmask_lane(m)) & mask;
+        step += HASHMAP_GROUP;
+        pos = (pos + step) & mask;
+    }
 }
 
-int hashmap_bucket(const struct hashmap *map, unsigned int hash)
+static void alloc_table(struct hashmap *map, unsigned int capacity)
 {
-	return hash & (map->tablesize - 1);
-}
-
-static void rehash(struct hashmap *map, unsigned int newsize)
+    size_t ctrl_size = (capacity + HASHMAP_GROUP + 7) & ~(size_t)7;
+    char *mem = hashmap_alloc(map,
+                              ctrl_size + (size_t)capacity * map->slot_size);
+    map->ctrl = (int8_t*)mem;
+    memset(map->ctrl, HASHMAP_CTRL_EMPTY, capacity + HASHMAP_GROUP);
+    map->slots = mem + ctrl_size;
+    map->capacity = capacity;
+    map->growth_left = growth_limit(capacity);
+}
+
+static void rehash(struct hashmap *map, unsigned int capacity)
+{
+    int8_t *old_ctrl = map->ctrl;
+    char *old_slots = map->slots;
+    unsigned int old_capacity = map->capacity;
+
+    alloc_table(map, capacity);
+    for (unsigned int i = 0; i < old_capacity; ++i) {
+        if (old_ctrl[i] < 0)
+            continue;
+        void *slot = old_slots + (size_t)i * map->slot_size;
+        uint64_t hash = map->hash_fn(slot);
+        size_t j = find_free_slot(map, hash);
+        set_ctrl(map, j, (int8_t)(hash & 0x7f));
+        memcpy(map->slots + j * map->slot_size, slot, map->slot_size);
+    }
+    map->growth_left -= map->size;
+}
+
+hashmap* hashmap_init(hcmp_fn cmp_fn, size_t initial_size)
 {
-	unsigned int i, oldsize = map->tablesize;
-	struct hashmap_entry **oldtable = map->table;
-
-	if (map->disallow_rehash)
-		return;
-
-	alloc_table(map, newsize);
-	for (i = 0; i < oldsize; i++) {
-		struct hashmap_entry *e = oldtable[i];
-		while (e) {
-			struct hashmap_entry *next = e->next;
-			unsigned int b = bucket(map, e);
-			e->next = map->table[b];
-			map->table[b] = e;
-			e = next;
-		}
-	}
-}
-
-static inline struct hashmap_entry **find_entry_ptr(const struct hashmap *map,
-        const struct hashmap_entry *key,
-                const void *keydata)
-{
-	struct hashmap_entry **e = &map->table[bucket(map, key)];
-	while (*e && !entry_equals(map, *e, key, keydata))
-		e = &(*e)->next;
-	return e;
-}
-
-static int always_equal(const void *u1, const void *u2, const void *u3)
-{
-	return 0;
-}
-
-hashmap* hashmap_init(hcmp_fn cmp_fn, size_t initial_size) {
     hashmap *map = make_obj(hashmap);
     map->pool = NULL;
-    hashmap_init_internal(map, cmp_fn, initial_size);
+    map->initial_size = (unsigned int)initial_size;
     return map;
 }
 
@@ -164,161 +149,73 @@ hashmap* hashmap_init_in(mem_pool *pool, hcmp_fn cmp_fn, size_t initial_size)
 {
     hashmap *map = make_obj_in(hashmap, pool);
     map->pool = pool;
-    hashmap_init_internal(map, cmp_fn, initial_size);
+    map->initial_size = (unsigned int)initial_size;
     return map;
 }
 
-void hashmap_init_internal(struct hashmap *map, hcmp_fn cmp_fn,
-                           size_t initial_size)
-{
-    mem_pool *pool = map->pool;
-	unsigned int size = HASHMAP_INITIAL_SIZE;
-
-	memset(map, 0, sizeof(*map));
-
-    map->pool = pool;
-
-	map->cmpfn = cmp_fn ? cmp_fn : always_equal;
-
-	/* calculate initial table size and allocate the table */
-	initial_size = (unsigned int) ((uint64_t) initial_size * 100
-			/ HASHMAP_LOAD_FACTOR);
-	while (initial_size > size)
-		size <<= HASHMAP_RESIZE_BITS; // default is 64 << 2
-	alloc_table(map, size);
-}
-
 void hashmap_free(struct hashmap *map, int free_entries)
 {
-	/*
-	 * TODO: memory pool release memory
-	 * */
-
-	//	if (!map || !map->table)
-	//		return;
-	//	if (free_entries) {
-	//		struct hashmap_iter iter;
-	//		struct hashmap_entry *e;
-	//		hashmap_iter_init(map, &iter);
-	//		while ((e = hashmap_iter_next(&iter)))
-	//			free(e);
-	//	}
-	//	free(map->table);
-	//	memset(map, 0, sizeof(*map));
-}
-
-void *hashmap_get(const struct hashmap *map,
-                  const void *key,
-                  const void *keydata)
-{
-	return *find_entry_ptr(map, key, keydata);
-}
-
-void *hashmap_get_next(const struct hashmap *map, const void *entry)
-{
-	struct hashmap_entry *e = ((struct hashmap_entry *) entry)->next;
-	for (; e; e = e->next)
-		if (entry_equals(map, entry, e, NULL))
-			return e;
-	return NULL;
-}
-
-void hashmap_add(struct hashmap *map, void *entry)
-{
-	unsigned int b = bucket(map, entry);
-
-	/* add entry */
-	((struct hashmap_entry *) entry)->next = map->table[b];
-	map->table[b] = entry;
-
-	/* fix size and rehash if appropriate */
-	map->size++;
-	if (map->size > map->grow_at)
-		rehash(map, map->tablesize << HASHMAP_RESIZE_BITS);
-}
-
-void *hashmap_remove(struct hashmap *map, const void *key, const void *keydata)
-{
-	struct hashmap_entry *old;
-	struct hashmap_entry **e = find_entry_ptr(map, key, keydata);
-	if (!*e)
-		return NULL;
-
-	/* remove existing entry */
-	old = *e;
-	*e = old->next;
-	old->next = NULL;
-
-	/* fix size and rehash if appropriate */
-	map->size--;
-	if (map->size < map->shrink_at)
-		rehash(map, map->tablesize >> HASHMAP_RESIZE_BITS);
-	return old;
-}
-
-void *hashmap_put(struct hashmap *map, void *entry)
-{
-	struct hashmap_entry *old = hashmap_remove(map, entry, NULL);
-	hashmap_add(map, entry);
-	return old;
+    /*
+     * TODO: memory pool release memory
+     * */
+}
+
+/**
+ * claims a free slot for hash and returns it zeroed, the caller writes
+ * the key and value. the table is allocated here on the first insert
+ **/
+void* hashmap_insert(struct hashmap *map,
+                     uint64_t hash,
+                     size_t slot_size,
+                     hslot_hash_fn hash_fn)
+{
+    if (map->capacity == 0) {
+        map->slot_size = (unsigned int)slot_size;
+        map->hash_fn = hash_fn;
+        unsigned int capacity = HASHMAP_MIN_CAPACITY;
+        while (growth_limit(capacity) < map->initial_size)
+            capacity <<= 1;
+        alloc_table(map, capacity);
+    }
+    else if (map->growth_left == 0) {
+        // mostly tombstones: clean up in place instead of growing
+        unsigned int capacity = map->capacity;
+        if (map->size * 2 > growth_limit(capacity))
+            capacity <<= 1;
+        rehash(map, capacity);
+    }
+
+    size_t i = find_free_slot(map, hash);
+    if (map->ctrl[i] == HASHMAP_CTRL_EMPTY)
+        map->growth_left--;
+    set_ctrl(map, i, (int8_t)(hash & 0x7f));
+    map->size++;
+
+    void *slot = map->slots + i * map->slot_size;
+    memset(slot, 0, map->slot_size);
+    return slot;
+}
+
+void hashmap_erase(struct hashmap *map, void *slot)
+{
+    size_t i = ((char*)slot - map->slots) / map->slot_size;
+    set_ctrl(map, i, HASHMAP_CTRL_DELETED);
+    map->size--;
 }
 
 void hashmap_iter_init(struct hashmap *map, struct hashmap_iter *iter)
 {
-	iter->map = map;
-	iter->tablepos = 0;
-	iter->next = NULL;
-}
-
-void *hashmap_iter_next(struct hashmap_iter *iter)
-{
-	struct hashmap_entry *current = iter->next;
-	for (;;) {
-		if (current) {
-			iter->next = current->next;
-			return current;
-		}
-
-		if (iter->tablepos >= iter->map->tablesize)
-			return NULL;
-
-		current = iter->map->table[iter->tablepos++];
-	}
-}
-
-struct pool_entry {
-	struct hashmap_entry ent;
-	size_t len;
-	unsigned char data[0];
-};
-
-static int pool_entry_cmp(const struct pool_entry *e1,
-		const struct pool_entry *e2,
-		const unsigned char *keydata)
-{
-	return e1->data != keydata &&
-		(e1->len != e2->len || memcmp(e1->data, keydata, e1->len));
+    iter->map = map;
+    iter->pos = 0;
 }
 
-const void *memintern(const void *data, size_t len)
+void* hashmap_iter_next(struct hashmap_iter *iter)
 {
-	static struct hashmap map;
-	struct pool_entry key, *e;
-
-	/* initialize string pool hashmap */
-	if (!map.tablesize)
-        hashmap_init_internal(&map, (hcmp_fn) pool_entry_cmp, 0);
-
-	/* lookup interned string in pool */
-	hashmap_entry_init(&key, memhash(data, len));
-	key.len = len;
-	e = hashmap_get(&map, &key, data);
-	if (!e) {
-		/* not found: create it */
-		FLEX_ALLOC_MEM(e, data, data, len);
-		hashmap_entry_init(e, key.ent.hash);
-		e->len = len;
-		hashmap_add(&map, e);
-	}
-	return e->data;
+    struct hashmap *map = iter->map;
+    while (iter->pos < map->capacity) {
+        unsigned int i = iter->pos++;
+        if (map->ctrl[i] >= 0)
+            return map->slots + (size_t)i * map->slot_size;
+    }
+    return NULL;
 }
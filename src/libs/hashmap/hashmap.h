@@ -1,158 +1,234 @@
-/*
-	 this code is copy form https://github.com/git/git/blob/master/hashmap.h
-	 */
-
 #ifndef HASHMAP_H
 #define HASHMAP_H
 
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include "mem_pool.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
-static inline size_t st_add(size_t a, size_t b)
-{
-	return a + b;
-}
-#define st_add3(a,b,c)   st_add(st_add((a),(b)),(c))
-#define st_add4(a,b,c,d) st_add(st_add3((a),(b),(c)),(d))
-
+/**
+ * swiss table: open addressing over groups of 16 control bytes.
+ * a control byte is EMPTY, DELETED or the low 7 bits of the hash of a
+ * full slot, one SSE2/NEON compare matches a whole group against them.
+ *
+ * key and value live inline in fixed size slots. the slot layout is
+ * only known to the typed wrappers in hashmap_tools, the map learns
+ * the slot size and how to rehash a slot on the first insert.
+ * slots move when the table grows, a slot pointer is only good until
+ * the next insert
+ **/
 
-#define FLEX_ALLOC_MEM(x, flexname, buf, len) do { 				\
-	size_t flex_array_len_ = (len); 							\
-	(x) = calloc(1, st_add3(sizeof(*(x)), flex_array_len_, 1)); \
-	memcpy((void *)(x)->flexname, (buf), flex_array_len_); 		\
-} while (0)
+#define HASHMAP_GROUP           16
+#define HASHMAP_MIN_CAPACITY    16
+#define HASHMAP_CTRL_EMPTY      ((int8_t)-128)
+#define HASHMAP_CTRL_DELETED    ((int8_t)-2)
 
-unsigned int strhash(const char *buf);
-unsigned int strihash(const char *buf);
-unsigned int memhash(const void *buf, size_t len);
-unsigned int memihash(const void *buf, size_t len);
-unsigned int memihash_cont(unsigned int seed, const void *buf, size_t len);
+uint64_t hash_bytes(const void *buf, size_t len);
 
-static inline unsigned int sha1hash(const unsigned char *sha1)
+static inline uint64_t hash_mix(uint64_t a, uint64_t b)
 {
-	/*
-	 * Equivalent to 'return *(unsigned int *)sha1;', but safe on
-	 * platforms that don't support unaligned reads.
-	 */
-	unsigned int hash;
-	memcpy(&hash, sha1, sizeof(hash));
-	return hash;
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
 }
 
-/* data structures */
+static inline uint64_t hash_int(uint64_t key)
+{
+    return hash_mix(key ^ 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull);
+}
 
-struct hashmap_entry {
-	struct hashmap_entry *next; // hashmap_entry is a stack data structure
-	unsigned int hash;
-};
+static inline uint64_t hash_str(const char *str)
+{
+    return hash_bytes(str, strlen(str));
+}
 
+// kept for hashmap_init callers, the typed wrappers compare inline
 typedef int (*hcmp_fn)(const void *entry, const void *entry_or_key,
                        const void *keydata);
 
+typedef bool (*heq_fn)(const void *slot, const void *key);
+
+typedef uint64_t (*hslot_hash_fn)(const void *slot);
+
 struct hashmap {
-    struct hashmap_entry **table;
-	hcmp_fn cmpfn;
-    unsigned int size;
-    unsigned int tablesize;
-    unsigned int grow_at;
-    unsigned int shrink_at;
-    mem_pool *pool;
-	unsigned disallow_rehash : 1;
+    int8_t          *ctrl;
+    char            *slots;
+    hslot_hash_fn   hash_fn;
+    unsigned int    slot_size;
+    unsigned int    size;
+    unsigned int    capacity;
+    unsigned int    growth_left;
+    unsigned int    initial_size;
+    mem_pool        *pool;
 };
 
 typedef struct hashmap hashmap;
 
 struct hashmap_iter {
-	struct hashmap *map;
-	struct hashmap_entry *next;
-	unsigned int tablepos;
+    struct hashmap *map;
+    unsigned int pos;
 };
 
-/* hashmap functions */
 hashmap* hashmap_init(hcmp_fn cmp_fn, size_t initial_size);
+
 hashmap* hashmap_init_in(mem_pool *pool, hcmp_fn cmp_fn, size_t initial_size);
-void hashmap_init_internal(struct hashmap *map, hcmp_fn cmp_fn,
-                                  size_t initial_size);
+
 void hashmap_free(struct hashmap *map, int free_entries);
 
-/* hashmap_entry functions */
+void* hashmap_insert(struct hashmap *map,
+                     uint64_t hash,
+                     size_t slot_size,
+                     hslot_hash_fn hash_fn);
+
+void hashmap_erase(struct hashmap *map, void *slot);
 
-static inline void hashmap_entry_init(void *entry, unsigned int hash)
+/* control byte groups */
+
+#if defined(__SSE2__)
+
+typedef __m128i hgroup;
+typedef uint32_t hmask;
+
+static inline hgroup hgroup_load(const int8_t *ctrl)
 {
-	struct hashmap_entry *e = entry;
-	e->hash = hash;
-	e->next = NULL;
+    return _mm_loadu_si128((const __m128i*)ctrl);
 }
-void *hashmap_get(const struct hashmap *map, const void *key,
-		const void *keydata);
-void *hashmap_get_next(const struct hashmap *map, const void *entry);
-void hashmap_add(struct hashmap *map, void *entry);
-void *hashmap_put(struct hashmap *map, void *entry);
-void *hashmap_remove(struct hashmap *map, const void *key,
-		const void *keydata);
 
-static inline void *hashmap_get_from_hash(const struct hashmap *map,
-		unsigned int hash, const void *keydata)
+static inline hmask hgroup_match(hgroup g, int8_t h2)
 {
-	struct hashmap_entry key;
-	hashmap_entry_init(&key, hash);
-	return hashmap_get(map, &key, keydata);
+    return (hmask)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), g));
 }
 
-int hashmap_bucket(const struct hashmap *map, unsigned int hash);
+// EMPTY and DELETED are the only bytes with the high bit set
+static inline hmask hgroup_match_free(hgroup g)
+{
+    return (hmask)_mm_movemask_epi8(g);
+}
 
-/*
- * Disallow/allow rehashing of the hashmap.
- * This is useful if the caller knows that the hashmap
- * needs multi-threaded access.  The caller is still
- * required to guard/lock searches and inserts in a
- * manner appropriate to their usage.  This simply
- * prevents the table from being unexpectedly re-mapped.
- *
- * If is up to the caller to ensure that the hashmap is
- * initialized to a reasonable size to prevent poor
- * performance.
- *
- * When value=1, prevent future rehashes on adds and deleted.
- * When value=0, allow future rehahses.  This DOES NOT force
- * a rehash now.
- */
-static inline void hashmap_disallow_rehash(struct hashmap *map, unsigned value)
+static inline unsigned int hmask_lane(hmask m)
 {
-	map->disallow_rehash = value;
+    return __builtin_ctz(m);
 }
 
-/* hashmap_iter functions */
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
 
-void hashmap_iter_init(struct hashmap *map, struct hashmap_iter *iter);
-void *hashmap_iter_next(struct hashmap_iter *iter);
-static inline void *hashmap_iter_first(struct hashmap *map,
-		struct hashmap_iter *iter)
+typedef int8x16_t hgroup;
+typedef uint64_t hmask;
+
+static inline hgroup hgroup_load(const int8_t *ctrl)
+{
+    return vld1q_s8(ctrl);
+}
+
+// one nibble per lane, only its top bit is kept
+static inline hmask hgroup_mask(uint8x16_t eq)
+{
+    uint8x8_t narrow = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrow), 0) &
+           0x8888888888888888ull;
+}
+
+static inline hmask hgroup_match(hgroup g, int8_t h2)
+{
+    return hgroup_mask(vceqq_s8(g, vdupq_n_s8(h2)));
+}
+
+static inline hmask hgroup_match_free(hgroup g)
+{
+    return hgroup_mask(vcltzq_s8(g));
+}
+
+static inline unsigned int hmask_lane(hmask m)
+{
+    return __builtin_ctzll(m) >> 2;
+}
+
+#else
+
+typedef const int8_t* hgroup;
+typedef uint32_t hmask;
+
+static inline hgroup hgroup_load(const int8_t *ctrl)
 {
-	hashmap_iter_init(map, iter);
-	return hashmap_iter_next(iter);
+    return ctrl;
 }
 
-/* string interning */
+static inline hmask hgroup_match(hgroup g, int8_t h2)
+{
+    hmask m = 0;
+    for (int i = 0; i < HASHMAP_GROUP; ++i)
+        m |= (hmask)(g[i] == h2) << i;
+    return m;
+}
 
-const void *memintern(const void *data, size_t len);
-static inline const char *strintern(const char *string)
+static inline hmask hgroup_match_free(hgroup g)
 {
-	return memintern(string, strlen(string));
+    hmask m = 0;
+    for (int i = 0; i < HASHMAP_GROUP; ++i)
+        m |= (hmask)(g[i] < 0) << i;
+    return m;
 }
 
-#define __hashmap_for_each(map)           				\
-        struct hashmap_iter __iter;     				\
-        hashmap_iter_init(map, &__iter); 				\
-        struct hashmap_entry *__entry;   				\
-        while ((__entry = hashmap_iter_next(&__iter))) 	\
+static inline unsigned int hmask_lane(hmask m)
+{
+    return __builtin_ctz(m);
+}
 
-#define hashmap_for_each(map, caller) 					\
-    do { 												\
-        __hashmap_for_each(map) { caller } 				\
-    } while(0) 											\
+#endif
+
+static inline hmask hgroup_match_empty(hgroup g)
+{
+    return hgroup_match(g, HASHMAP_CTRL_EMPTY);
+}
+
+/**
+ * triangular probing over the groups, it visits every group of a power
+ * of two table. at least one EMPTY byte is always left, so a miss ends
+ **/
+static inline void* hashmap_find(const struct hashmap *map,
+                                 uint64_t hash,
+                                 const void *key,
+                                 heq_fn eq)
+{
+    if (map->size == 0)
+        return NULL;
+    size_t mask = map->capacity - 1;
+    size_t pos = (hash >> 7) & mask;
+    int8_t h2 = (int8_t)(hash & 0x7f);
+    size_t step = 0;
+    for (;;) {
+        hgroup g = hgroup_load(map->ctrl + pos);
+        for (hmask m = hgroup_match(g, h2); m != 0; m &= m - 1) {
+            size_t i = (pos + hmask_lane(m)) & mask;
+            void *slot = map->slots + i * map->slot_size;
+            if (eq(slot, key))
+                return slot;
+        }
+        if (hgroup_match_empty(g) != 0)
+            return NULL;
+        step += HASHMAP_GROUP;
+        pos = (pos + step) & mask;
+    }
+}
+
+/* hashmap_iter functions */
+
+void hashmap_iter_init(struct hashmap *map, struct hashmap_iter *iter);
+
+void* hashmap_iter_next(struct hashmap_iter *iter);
+
+static inline void* hashmap_iter_first(struct hashmap *map,
+                                       struct hashmap_iter *iter)
+{
+    hashmap_iter_init(map, iter);
+    return hashmap_iter_next(iter);
+}
 
 #endif
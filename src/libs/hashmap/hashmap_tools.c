@@ -1,86 +1,76 @@
 #include "parser/class/class_tools.h"
 #include "libs/hashmap/hashmap_tools.h"
 
-#define DEFINE_HASHMAP_BODY(tk, tv)                                     \
-    tk##_to_##tv*                                                       \
-    find_##tk##_to_##tv##_entry(hashmap *_map, tk key)                  \
+/**
+ * every typed map instantiates hashmap_find with its own key compare
+ * and slot hash, the compiler inlines both into the probe loop
+ **/
+#define DEFINE_HASHMAP_SLOT(tk, tv, hash_key, key_eq)                   \
+    static inline uint64_t                                              \
+    tk##_to_##tv##_hash(const void *slot)                               \
     {                                                                   \
-        tk##_to_##tv k;                                                 \
-        hashmap_entry_init(&k, memihash(&key, sizeof(tk)));             \
-        k.key = key;                                                    \
-        return (tk##_to_##tv*) hashmap_get(_map, &k, NULL);             \
+        tk key = ((const tk##_to_##tv*)slot)->key;                      \
+        return hash_key;                                                \
     }                                                                   \
                                                                         \
-    int                                                                 \
-    tk##_to_##tv##_cmp(const tk##_to_##tv *e1,                          \
-            const tk##_to_##tv *e2, const void *unused)                 \
+    static inline bool                                                  \
+    tk##_to_##tv##_eq(const void *slot, const void *key_ptr)            \
     {                                                                   \
-        return e1->key != e2->key;                                      \
+        tk a = ((const tk##_to_##tv*)slot)->key;                        \
+        tk b = *(const tk*)key_ptr;                                     \
+        return key_eq;                                                  \
+    }                                                                   \
+                                                                        \
+    tk##_to_##tv*                                                       \
+    find_##tk##_to_##tv##_entry(hashmap *_map, tk key)                  \
+    {                                                                   \
+        tk##_to_##tv slot = { .key = key };                             \
+        return hashmap_find(_map, tk##_to_##tv##_hash(&slot), &key,     \
+                            tk##_to_##tv##_eq);                         \
     }                                                                   \
                                                                         \
     void                                                                \
     hashmap_set_##tk##_to_##tv(hashmap *_map, tk key, tv value)         \
     {                                                                   \
-        tk##_to_##tv *e = find_##tk##_to_##tv##_entry(_map, key);       \
+        tk##_to_##tv slot = { .key = key };                             \
+        uint64_t hash = tk##_to_##tv##_hash(&slot);                     \
+        tk##_to_##tv *e = hashmap_find(_map, hash, &key,                \
+                                       tk##_to_##tv##_eq);              \
         if (!e) {                                                       \
-            if (_map->pool == NULL)                                     \
-                e = x_alloc(sizeof(tk##_to_##tv));                      \
-            else                                                        \
-                e = mem_pool_alloc(_map->pool, sizeof(tk##_to_##tv));   \
-            hashmap_entry_init(e, memihash(&key, sizeof(tk)));          \
+            e = hashmap_insert(_map, hash, sizeof(tk##_to_##tv),        \
+                               tk##_to_##tv##_hash);                    \
             e->key = key;                                               \
-            hashmap_add(_map, e);                                       \
         }                                                               \
         e->value = value;                                               \
     }                                                                   \
+                                                                        \
     void                                                                \
     hashmap_remove_##tk##_to_##tv(hashmap *_map, tk key)                \
     {                                                                   \
-        tk##_to_##tv k;                                                 \
-        hashmap_entry_init(&k, memihash(&key, sizeof(tk)));             \
-        k.key = key;                                                    \
-        hashmap_remove(_map, &k, NULL);                                 \
+        tk##_to_##tv *e = find_##tk##_to_##tv##_entry(_map, key);       \
+        if (e != NULL)                                                  \
+            hashmap_erase(_map, e);                                     \
     }                                                                   \
 
-#define DEFINE_HASHMAP_BODY_WITH_STRING_KEY(tk, tv)                     \
-    tk##_to_##tv*                                                       \
-    find_##tk##_to_##tv##_entry(hashmap *_map, tk key)                  \
-    {                                                                   \
-        tk##_to_##tv k;                                                 \
-        hashmap_entry_init(&k, strhash(key));                           \
-        k.key = key;                                                    \
-        return (tk##_to_##tv*) hashmap_get(_map, &k, NULL);             \
-    }                                                                   \
+#define DEFINE_HASHMAP_BODY(tk, tv)                                     \
+    DEFINE_HASHMAP_SLOT(tk, tv, hash_int((uint64_t)key), a == b)        \
                                                                         \
     int                                                                 \
     tk##_to_##tv##_cmp(const tk##_to_##tv *e1,                          \
             const tk##_to_##tv *e2, const void *unused)                 \
     {                                                                   \
-        return strcmp(e1->key, e2->key);                                \
+        return e1->key != e2->key;                                      \
     }                                                                   \
+
+#define DEFINE_HASHMAP_BODY_WITH_STRING_KEY(tk, tv)                     \
+    DEFINE_HASHMAP_SLOT(tk, tv, hash_str(key),                          \
+                        a == b || strcmp(a, b) == 0)                    \
                                                                         \
-    void                                                                \
-    hashmap_set_##tk##_to_##tv(hashmap *_map, tk key, tv value)         \
-    {                                                                   \
-        tk##_to_##tv *e = find_##tk##_to_##tv##_entry(_map, key);       \
-        if (!e) {                                                       \
-            if (_map->pool == NULL)                                     \
-                e = x_alloc(sizeof(tk##_to_##tv));                      \
-            else                                                        \
-                e = mem_pool_alloc(_map->pool, sizeof(tk##_to_##tv));   \
-            hashmap_entry_init(e, strhash(key));                        \
-            e->key = key;                                               \
-            hashmap_add(_map, e);                                       \
-        }                                                               \
-        e->value = value;                                               \
-    }                                                                   \
-    void                                                                \
-    hashmap_remove_##tk##_to_##tv(hashmap *_map, tk key)                \
+    int                                                                 \
+    tk##_to_##tv##_cmp(const tk##_to_##tv *e1,                          \
+            const tk##_to_##tv *e2, const void *unused)                 \
     {                                                                   \
-        tk##_to_##tv k;                                                 \
-        hashmap_entry_init(&k, strhash(key));                           \
-        k.key = key;                                                    \
-        hashmap_remove(_map, &k, NULL);                                 \
+        return strcmp(e1->key, e2->key);                                \
     }                                                                   \
 
 
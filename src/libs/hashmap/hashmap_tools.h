@@ -6,7 +6,6 @@
 
 #define DEFINE_HASHMAP_HEAD(tk, tv)                                 \
     typedef struct tk##_to_##tv {                                   \
-        struct hashmap_entry ent;                                   \
         tk key;                                                     \
         tv value;                                                   \
     } tk##_to_##tv;                                                 \
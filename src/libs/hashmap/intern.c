@@ -0,0 +1,95 @@
+#include "intern.h"
+
+#define INTERN_POOL_CAPACITY 4096
+
+typedef struct {
+    string  key;
+    size_t  len;
+} jd_intern_slot;
+
+typedef struct {
+    const char  *s;
+    size_t      len;
+} jd_intern_key;
+
+static __thread jd_intern *current_table = NULL;
+
+static uint64_t intern_slot_hash(const void *slot)
+{
+    const jd_intern_slot *e = slot;
+    return hash_bytes(e->key, e->len);
+}
+
+static bool intern_slot_eq(const void *slot, const void *key)
+{
+    const jd_intern_slot *e = slot;
+    const jd_intern_key *k = key;
+    return e->len == k->len && memcmp(e->key, k->s, k->len) == 0;
+}
+
+/**
+ * the shard pools are adopted by owner, they go away with the dex/jar.
+ * only the thread owning owner may create the table
+ **/
+jd_intern* intern_create(mem_pool *owner)
+{
+    jd_intern *table = make_obj_in(jd_intern, owner);
+    for (int i = 0; i < INTERN_SHARDS; ++i) {
+        jd_intern_shard *shard = &table->shards[i];
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->pool = mem_pool_init(INTERN_POOL_CAPACITY);
+        shard->map = hashmap_init_in(shard->pool, NULL, 0);
+        mem_pool_adopt(owner, shard->pool);
+    }
+    return table;
+}
+
+string intern_bytes(jd_intern *table, const char *s, size_t len)
+{
+    uint64_t hash = hash_bytes(s, len);
+    jd_intern_shard *shard =
+            &table->shards[hash >> (64 - INTERN_SHARD_BITS)];
+    jd_intern_key key = { .s = s, .len = len };
+
+    pthread_mutex_lock(&shard->lock);
+    jd_intern_slot *e = hashmap_find(shard->map, hash, &key, intern_slot_eq);
+    if (e == NULL) {
+        string copy = mem_pool_alloc(shard->pool, len + 1);
+        memcpy(copy, s, len);
+        copy[len] = '\0';
+        e = hashmap_insert(shard->map, hash, sizeof(jd_intern_slot),
+                           intern_slot_hash);
+        e->key = copy;
+        e->len = len;
+    }
+    string result = e->key;
+    pthread_mutex_unlock(&shard->lock);
+    return result;
+}
+
+jd_intern* intern_scope_enter(jd_intern *table)
+{
+    jd_intern *previous = current_table;
+    current_table = table;
+    return previous;
+}
+
+void intern_scope_leave(jd_intern *previous)
+{
+    current_table = previous;
+}
+
+jd_intern* intern_scope()
+{
+    return current_table;
+}
+
+string str_intern_n(const char *s, size_t len)
+{
+    if (current_table != NULL)
+        return intern_bytes(current_table, s, len);
+    string copy = x_alloc(len + 1);
+    memcpy(copy, s, len);
+    copy[len] = '\0';
+    return copy;
+}
@@ -0,0 +1,51 @@
+#ifndef GARLIC_INTERN_H
+#define GARLIC_INTERN_H
+
+#include <pthread.h>
+#include "hashmap.h"
+#include "types.h"
+
+/**
+ * string interning scoped to one dex or jar. the workers decompiling
+ * its classes share the table, equal strings interned through it are
+ * the same pointer and live as long as the dex/jar pool.
+ *
+ * the table is split into shards by the top bits of the hash, every
+ * shard has its own lock, map and pool.
+ *
+ * the table in use is a per thread scope entered by the class tasks.
+ * outside of a scope str_intern_n falls back to a copy in the current
+ * pool, so callers never depend on a scope being set
+ **/
+
+#define INTERN_SHARD_BITS   5
+#define INTERN_SHARDS       (1 << INTERN_SHARD_BITS)
+
+typedef struct {
+    pthread_mutex_t lock;
+    hashmap         *map;
+    mem_pool        *pool;
+} jd_intern_shard;
+
+typedef struct {
+    jd_intern_shard shards[INTERN_SHARDS];
+} jd_intern;
+
+jd_intern* intern_create(mem_pool *owner);
+
+string intern_bytes(jd_intern *table, const char *s, size_t len);
+
+jd_intern* intern_scope_enter(jd_intern *table);
+
+void intern_scope_leave(jd_intern *previous);
+
+jd_intern* intern_scope();
+
+string str_intern_n(const char *s, size_t len);
+
+static inline string str_intern(const char *s)
+{
+    return str_intern_n(s, strlen(s));
+}
+
+#endif //GARLIC_INTERN_H
@@ -9,6 +9,7 @@
         list->size = 0;                                                       \
         list->capacity = LIST_INITIAL_CAPACITY;                               \
         list->cmp_fn = NULL;                                                  \
+        list->pool = x_current_pool();                                        \
         return list;                                                          \
     }                                                                         \
                                                                               \
@@ -26,6 +27,7 @@
         list->size = 0;                                                       \
         list->capacity = capacity;                                            \
         list->cmp_fn = NULL;                                                  \
+        list->pool = x_current_pool();                                        \
         return list;                                                          \
     }                                                                         \
                                                                               \
@@ -42,6 +44,23 @@
         return list;                                                          \
     }                                                                         \
                                                                               \
+    /**                                                                       \
+     * one allocation, data right behind the header. the inline data is a    \
+     * plain pool region: growing reallocs it in place or copies it out and  \
+     * hands the old tail to the free list, the same as any list             \
+     **/                                                                      \
+    list_##type* linit_##type##_small()                                       \
+    {                                                                         \
+        list_##type* list = (list_##type*) x_alloc(sizeof(list_##type) +      \
+                LIST_SMALL_CAPACITY * sizeof(type));                          \
+        list->data = (type*)(list + 1);                                       \
+        list->size = 0;                                                       \
+        list->capacity = LIST_SMALL_CAPACITY;                                 \
+        list->cmp_fn = NULL;                                                  \
+        list->pool = x_current_pool();                                        \
+        return list;                                                          \
+    }                                                                         \
+                                                                              \
     list_##type* linit_##type##_with_fn_and_pool(list_cmp_fn cmp_fn,          \
             mem_pool *pool)                                                   \
     {                                                                         \
@@ -68,12 +87,9 @@
         if (list->size == list->capacity) {                                   \
             size_t old_size = list->capacity;                                 \
             list->capacity *= LIST_GROWTH_FACTOR;                             \
-            if (list->pool == NULL)                                           \
-                list->data = (type*)x_realloc(list->data,                     \
-                    old_size*sizeof(type),                                    \
-                    list->capacity * sizeof(type));                           \
-            else                                                              \
-                list->data = (type*)x_realloc_in(list->pool, list->data,      \
+            if (list->capacity == 0)                                          \
+                list->capacity = LIST_INITIAL_CAPACITY;                       \
+            list->data = (type*)x_realloc_in(list->pool, list->data,          \
                     old_size*sizeof(type),                                    \
                     list->capacity * sizeof(type));                           \
         }                                                                     \
@@ -131,8 +147,9 @@
     }                                                                         \
                                                                               \
     void lfree_##type(list_##type* list) {                                    \
-        free(list->data);                                                     \
-        free(list);                                                           \
+        mem_pool_release(list->pool, list->data,                              \
+                         list->capacity * sizeof(type));                      \
+        mem_pool_release(list->pool, list, sizeof(list_##type));              \
     }                                                                         \
 
 
@@ -179,15 +196,14 @@ void ladd_obj_at(list_object *list, object element, size_t index)
     if (list->size == list->capacity) {
         size_t old_size = list->capacity;
         list->capacity *= LIST_GROWTH_FACTOR;
+        if (list->capacity == 0)
+            list->capacity = LIST_INITIAL_CAPACITY;
         size_t _old = old_size*sizeof(object*);
         size_t _new = list->capacity*sizeof(object*);
-        if (list->pool == NULL)
-            list->data = (object*)x_realloc(list->data,_old, _new);
-        else
-            list->data = (object*)x_realloc_in(list->pool, 
-                                               list->data, 
-                                               _old, 
-                                               _new);
+        list->data = (object*)x_realloc_in(list->pool,
+                                           list->data,
+                                           _old,
+                                           _new);
     }
     for (size_t i = list->size; i > index; i--) {
         list->data[i] = list->data[i - 1];
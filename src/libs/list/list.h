@@ -10,9 +10,19 @@
 /**
  * 这里将list初始定义的如此小是因为用到最多的地方是instruction
  * instruction内有4个list, 而且这些list的元素个数一般不会太多
+ *
+ * list会记住创建时所在的mem_pool, 扩容时在同一个pool里realloc:
+ * 数据在当前block末尾时原地扩展, 否则旧的数据区回收到pool的free list
+ *
+ * small list: 前LIST_SMALL_CAPACITY个元素直接放在header后面, 和header
+ * 一次分配. 用在instruction和block的边上(targets/jumps/comings/in/out/
+ * dom_children), 这些list几乎都只有1-2个元素. 超出时才在pool里分配
+ * 数据区, 对外仍然是普通的list
  **/
 #define LIST_INITIAL_CAPACITY 4
 
+#define LIST_SMALL_CAPACITY 2
+
 #define LIST_GROWTH_FACTOR 2
 
 typedef int (*list_cmp_fn)(const void *, const void *);
@@ -40,6 +50,8 @@ typedef int (*list_cmp_fn)(const void *, const void *);
                                                                             \
     list_##type* linit_##type##_with_pool(mem_pool *pool);                  \
                                                                             \
+    list_##type* linit_##type##_small();                                    \
+                                                                            \
     void ladd_##type(list_##type* list, type element);                      \
                                                                             \
     void lremove_##type(list_##type* list, size_t index);                   \
@@ -90,6 +102,8 @@ void ladd_obj_at(list_object *list, object element, size_t index);
 #define lget_obj_last(list)  (lget_object_last(list))
 #define ladd_obj(list, element) (ladd_object(list, element))
 
+#define linit_obj_small() (linit_object_small())
+
 #define is_list_last(list, index) ((index) == (list)->size - 1)
 #define is_list_empty(list) ((list) == NULL || (list)->size == 0)
 
@@ -1,30 +1,40 @@
 #include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 #include "mem_pool.h"
 #include "libs/threadpool/threadpool.h"
 
 mem_pool *global_pool;
 
+#define MEM_POOL_ALIGN(size) \
+    (((size) + MEM_POOL_ALIGNMENT - 1) & ~((size_t)MEM_POOL_ALIGNMENT - 1))
+
 void mem_init_pool() {
-    global_pool = mem_pool_init(16 * 1024);
+    global_pool = mem_pool_init(MEM_POOL_SMALL_CAPACITY);
 }
 
 mem_pool* mem_create_pool()
 {
-    return mem_pool_init(16*1024);
+    return mem_pool_init(MEM_POOL_SMALL_CAPACITY);
 }
 
-static int alloc_count = 0;
-
-void* x_alloc(size_t size)
+mem_pool* x_current_pool()
 {
-    // TODO: use global mem_pool *pool
     thread_local_data *tls = get_thread_local_data();
 
     if (tls && tls->pool) {
-        return mem_pool_alloc(tls->pool, size);
+        return tls->pool;
     }
-    return mem_pool_alloc(global_pool, size);
-//    return malloc(size);
+    return global_pool;
+}
+
+void* x_alloc(size_t size)
+{
+    return mem_pool_alloc(x_current_pool(), size);
 }
 
 void* x_alloc_in(mem_pool *pool, size_t size)
@@ -32,14 +42,19 @@ void* x_alloc_in(mem_pool *pool, size_t size)
     return mem_pool_alloc(pool, size);
 }
 
-void* x_realloc(void *ptr, size_t old_size, size_t new_size)
+void* x_alloc_raw(size_t size)
 {
-    thread_local_data *tls = get_thread_local_data();
+    return mem_pool_alloc_raw(x_current_pool(), size);
+}
 
-    if (tls && tls->pool) {
-        return mem_pool_realloc(tls->pool, ptr, old_size, new_size);
-    }
-    return mem_pool_realloc(global_pool, ptr, old_size, new_size);
+void* x_alloc_raw_in(mem_pool *pool, size_t size)
+{
+    return mem_pool_alloc_raw(pool, size);
+}
+
+void* x_realloc(void *ptr, size_t old_size, size_t new_size)
+{
+    return mem_pool_realloc(x_current_pool(), ptr, old_size, new_size);
 }
 
 void* x_realloc_in(mem_pool *pool, void *ptr, size_t old_size, size_t new_size)
@@ -56,12 +71,16 @@ mem_pool* mem_pool_init(size_t capacity)
 {
     size_t total_size = sizeof(mem_pool) + sizeof(small_block) + capacity;
     void *temp = malloc(total_size);
-    memset(temp, 0, total_size);
+    if (temp == NULL) {
+        perror("Failed to allocate memory pool");
+        exit(EXIT_FAILURE);
+    }
+    memset(temp, 0, sizeof(mem_pool) + sizeof(small_block));
 
     mem_pool *pool = (mem_pool*)temp;
     pool->small_buffer_capacity = capacity;
+    pool->next_block_capacity = capacity * 2;
     pool->big_block_start = NULL;
-    memset(pool->small_block_start, 0, sizeof(small_block));
     pool->cur_usable_small_block = (small_block*)(pool->small_block_start);
     pool->total_size = total_size;
 
@@ -69,20 +88,49 @@ mem_pool* mem_pool_init(size_t capacity)
     sbp->cur_usable_buffer = (u1*)(sbp + 1);
     sbp->buffer_end = sbp->cur_usable_buffer+capacity;
     sbp->next_block = NULL;
-    sbp->no_enough_times = 0;
+    sbp->capacity = capacity;
 
     return pool;
 }
 
+static void mem_pool_unmap_files(mem_pool *pool)
+{
+#ifndef _WIN32
+    mem_mapped_file *mf = pool->mapped_start;
+    while (mf) {
+        munmap(mf->addr, mf->size);
+        mf = mf->next;
+    }
+#endif
+    pool->mapped_start = NULL;
+}
+
+static void mem_pool_free_adopted(mem_pool *pool)
+{
+    mem_pool *child = pool->adopted_start;
+    while (child) {
+        mem_pool *next = child->next_adopted;
+        mem_pool_free(child);
+        child = next;
+    }
+    pool->adopted_start = NULL;
+}
+
+void mem_pool_adopt(mem_pool *pool, mem_pool *child)
+{
+    child->next_adopted = pool->adopted_start;
+    pool->adopted_start = child;
+}
+
 void mem_pool_free(mem_pool *pool){
+    mem_pool_free_adopted(pool);
+    mem_pool_unmap_files(pool);
+
     big_block *bbp = pool->big_block_start;
-    while (bbp)
-    {
-        if (bbp->big_buffer) {
-            free(bbp->big_buffer);
-            bbp->big_buffer = NULL;
-        }
-        bbp = bbp->next_block;
+    while (bbp) {
+        big_block *next = bbp->next_block;
+        free(bbp);
+        bbp = next;
     }
 
     small_block *temp = pool->small_block_start->next_block;
@@ -94,103 +142,355 @@ void mem_pool_free(mem_pool *pool){
     free(pool);
 }
 
+static inline u1* small_block_bump(small_block *sbp, size_t size)
+{
+    if ((size_t)(sbp->buffer_end - sbp->cur_usable_buffer) < size)
+        return NULL;
+    u1 *res = sbp->cur_usable_buffer;
+    sbp->cur_usable_buffer = res + size;
+    return res;
+}
+
 u1* mem_pool_new_small_block(mem_pool *pool, size_t size)
 {
-    size_t malloc_size = sizeof(small_block) + pool->small_buffer_capacity;
-    pool->total_size += malloc_size;
+    small_block *cur = pool->cur_usable_small_block;
+    size_t capacity = pool->next_block_capacity;
+    if (capacity < size)
+        capacity = size;
+
+    size_t malloc_size = sizeof(small_block) + capacity;
     void *temp = malloc(malloc_size);
-    memset(temp, 0, malloc_size);
+    if (temp == NULL) {
+        perror("Failed to allocate memory pool block");
+        exit(EXIT_FAILURE);
+    }
+    pool->total_size += malloc_size;
+
+    if (pool->next_block_capacity < MEM_POOL_MAX_BLOCK_CAPACITY)
+        pool->next_block_capacity *= 2;
 
     small_block *sbp = (small_block*) temp;
     sbp->cur_usable_buffer = (u1*)(sbp+1);
-    sbp->buffer_end = (u1*)temp + malloc_size;
-    sbp->next_block = NULL;
-    sbp->no_enough_times = 0;
+    sbp->buffer_end = sbp->cur_usable_buffer + capacity;
+    sbp->capacity = capacity;
 
-    u1 *res = sbp->cur_usable_buffer;
-    sbp->cur_usable_buffer = res + size;
+    // the current block is always the one being filled, keep it O(1)
+    sbp->next_block = cur->next_block;
+    cur->next_block = sbp;
+    pool->cur_usable_small_block = sbp;
 
+    return small_block_bump(sbp, size);
+}
 
-    small_block *p = pool->cur_usable_small_block;
-    while (p->next_block) {
-        if (p->no_enough_times > 4) {
-            pool->cur_usable_small_block = p->next_block;
-        }
-        ++(p->no_enough_times);
-        p = p->next_block;
+u1* mem_pool_new_big_block(mem_pool *pool, size_t size)
+{
+    size_t malloc_size = sizeof(big_block) + size;
+    big_block *bbp = malloc(malloc_size);
+    if (bbp == NULL) {
+        perror("Failed to allocate memory pool big block");
+        exit(EXIT_FAILURE);
     }
+    pool->total_size += malloc_size;
+    bbp->big_buffer = (u1*)(bbp + 1);
+    bbp->size = size;
+    bbp->next_block = pool->big_block_start;
+    pool->big_block_start = bbp;
+    return bbp->big_buffer;
+}
 
-    p->next_block = sbp;
-
-    if (pool->cur_usable_small_block == NULL) {
-        pool->cur_usable_small_block = sbp;
+void mem_pool_free_big_block(mem_pool *pool, u1 *buffer_ptr)
+{
+    big_block **link = &pool->big_block_start;
+    while (*link) {
+        big_block *bbp = *link;
+        if (bbp->big_buffer == buffer_ptr) {
+            *link = bbp->next_block;
+            pool->total_size -= sizeof(big_block) + bbp->size;
+            free(bbp);
+            return;
+        }
+        link = &bbp->next_block;
     }
-    return res;
 }
 
-static int big_block_count = 0;
-
-u1* mem_pool_new_big_block(mem_pool *pool, size_t size)
+/**
+ * rewind the pool to its first block, small blocks up to retain_capacity
+ * (the high-water set) are kept and reused, the rest is freed
+ **/
+void mem_pool_trim(mem_pool *pool, size_t retain_capacity)
 {
-    big_block_count++;
-    void *temp = malloc(size);
-    memset(temp, 0, size);
-    pool->total_size += size;
+    mem_pool_free_adopted(pool);
+    mem_pool_unmap_files(pool);
+
     big_block *bbp = pool->big_block_start;
-    int i = 0;
     while (bbp) {
-        if (bbp->big_buffer == NULL) {
-            bbp->big_buffer = (u1*)temp;
-            return bbp->big_buffer;
-        }
-        if (i > 3)
+        big_block *next = bbp->next_block;
+        free(bbp);
+        bbp = next;
+    }
+    pool->big_block_start = NULL;
+
+    memset(pool->free_lists, 0, sizeof(pool->free_lists));
+    pool->free_regions = 0;
+
+    small_block *first = pool->small_block_start;
+    size_t retained = first->capacity;
+    size_t total_size = sizeof(mem_pool) + sizeof(small_block) +
+                        first->capacity;
+    size_t next_capacity = first->capacity * 2;
+
+    small_block *sbp = first;
+    sbp->cur_usable_buffer = (u1*)(sbp + 1);
+    while (sbp->next_block) {
+        small_block *next = sbp->next_block;
+        if (retained + next->capacity > retain_capacity) {
+            sbp->next_block = NULL;
+            while (next) {
+                small_block *n = next->next_block;
+                free(next);
+                next = n;
+            }
             break;
-        bbp = bbp->next_block;
-        ++i;
+        }
+        retained += next->capacity;
+        total_size += sizeof(small_block) + next->capacity;
+        next->cur_usable_buffer = (u1*)(next + 1);
+        if (next->capacity * 2 > next_capacity)
+            next_capacity = next->capacity * 2;
+        sbp = next;
     }
 
-    big_block *new_bbp = (big_block*) mem_pool_alloc(pool, sizeof(big_block));
-    new_bbp->big_buffer = (u1*)temp;
-    new_bbp->next_block = pool->big_block_start;
-    pool->big_block_start = new_bbp;
-    return new_bbp->big_buffer;
+    if (next_capacity > MEM_POOL_MAX_BLOCK_CAPACITY)
+        next_capacity = MEM_POOL_MAX_BLOCK_CAPACITY;
+    pool->next_block_capacity = next_capacity;
+    pool->cur_usable_small_block = first;
+    pool->total_size = total_size;
 }
 
-void* mem_pool_alloc(mem_pool *pool, size_t size){
-    if(size < pool->small_buffer_capacity) {
-        small_block *temp = pool->cur_usable_small_block;
-        do {
-            if (temp->buffer_end-temp->cur_usable_buffer > size) {
-                u1 *res = temp->cur_usable_buffer;
-                temp->cur_usable_buffer = temp->cur_usable_buffer + size;
-                return res;
-            }
-            temp = temp->next_block;
-        } while (temp);
-        return mem_pool_new_small_block(pool, size);
+void mem_pool_clear(mem_pool *pool)
+{
+    mem_pool_trim(pool, MEM_POOL_RETAIN_CAPACITY);
+}
+
+// <editor-fold defaultstate="collapsed" desc="size class free lists">
+
+static inline int size_class_of_region(size_t size)
+{
+    if (size < ((size_t)1 << MEM_POOL_MIN_CLASS_SHIFT))
+        return -1;
+    int cls = 63 - __builtin_clzll((unsigned long long)size) -
+              MEM_POOL_MIN_CLASS_SHIFT;
+    return cls < MEM_POOL_SIZE_CLASSES ? cls : MEM_POOL_SIZE_CLASSES - 1;
+}
+
+static inline int size_class_of_request(size_t size)
+{
+    if (size <= ((size_t)1 << MEM_POOL_MIN_CLASS_SHIFT))
+        return 0;
+    int cls = 64 - __builtin_clzll((unsigned long long)(size - 1)) -
+              MEM_POOL_MIN_CLASS_SHIFT;
+    return cls < MEM_POOL_SIZE_CLASSES ? cls : -1;
+}
+
+static u1* mem_pool_bump(mem_pool *pool, size_t size)
+{
+    u1 *res = small_block_bump(pool->cur_usable_small_block, size);
+    if (res != NULL)
+        return res;
+
+    // a block which is already chained after the current one
+    small_block *next = pool->cur_usable_small_block->next_block;
+    while (next != NULL) {
+        pool->cur_usable_small_block = next;
+        res = small_block_bump(next, size);
+        if (res != NULL)
+            return res;
+        next = next->next_block;
+    }
+    return mem_pool_new_small_block(pool, size);
+}
+
+static void* free_list_pop(mem_pool *pool, size_t size)
+{
+    int cls = size_class_of_request(size);
+    if (cls < 0)
+        return NULL;
+    mem_free_list *fl = &pool->free_lists[cls];
+    if (fl->size == 0)
+        return NULL;
+    pool->free_regions--;
+    return fl->regions[--fl->size];
+}
+
+static void free_list_push(mem_pool *pool, void *ptr, size_t size)
+{
+    int cls = size_class_of_region(size);
+    if (cls < 0)
+        return;
+    mem_free_list *fl = &pool->free_lists[cls];
+    if (fl->size == fl->capacity) {
+        size_t capacity = fl->capacity == 0 ? 16 : fl->capacity * 2;
+        void **regions = (void**)mem_pool_bump(pool, sizeof(void*) * capacity);
+        if (fl->size > 0)
+            memcpy(regions, fl->regions, sizeof(void*) * fl->size);
+        fl->regions = regions;
+        fl->capacity = capacity;
+    }
+    fl->regions[fl->size++] = ptr;
+    pool->free_regions++;
+}
+
+static inline bool is_last_allocation(mem_pool *pool, void *ptr, size_t size)
+{
+    return (u1*)ptr + size == pool->cur_usable_small_block->cur_usable_buffer;
+}
+
+static bool small_block_owns(mem_pool *pool, void *ptr, size_t size)
+{
+    small_block *sbp = pool->small_block_start;
+    while (sbp) {
+        if ((u1*)ptr >= (u1*)(sbp + 1) && (u1*)ptr + size <= sbp->buffer_end)
+            return true;
+        sbp = sbp->next_block;
+    }
+    return false;
+}
+
+/**
+ * x_realloc releases into the current pool of the thread, which is not
+ * always the pool ptr came from (worker arena, class pool, method task
+ * arena). a foreign region is left alone, it would be handed out again
+ * after its own pool is cleared
+ **/
+void mem_pool_release(mem_pool *pool, void *ptr, size_t size)
+{
+    if (ptr == NULL)
+        return;
+    size = MEM_POOL_ALIGN(size);
+    if (size >= pool->small_buffer_capacity)
+        mem_pool_free_big_block(pool, ptr);
+    else if (is_last_allocation(pool, ptr, size))
+        pool->cur_usable_small_block->cur_usable_buffer = ptr;
+    else if (small_block_owns(pool, ptr, size))
+        free_list_push(pool, ptr, size);
+}
+
+// </editor-fold>
+
+void* mem_pool_alloc_raw(mem_pool *pool, size_t size)
+{
+    size = MEM_POOL_ALIGN(size);
+    pool->alloc_bytes += size;
+    if (size >= pool->small_buffer_capacity)
+        return mem_pool_new_big_block(pool, size);
+
+    if (pool->free_regions > 0) {
+        void *res = free_list_pop(pool, size);
+        if (res != NULL)
+            return res;
     }
-    return mem_pool_new_big_block(pool, size);
+    return mem_pool_bump(pool, size);
 }
 
-void* mem_pool_realloc(mem_pool *pool, void *ptr, size_t old_size, 
+void* mem_pool_alloc(mem_pool *pool, size_t size)
+{
+    void *res = mem_pool_alloc_raw(pool, size);
+    memset(res, 0, size);
+    return res;
+}
+
+void* mem_pool_realloc(mem_pool *pool, void *ptr, size_t old_size,
                        size_t new_size)
 {
-    // this is alloc a new pointer shit
-    void *new_ptr = mem_pool_alloc(pool, new_size);
-    memset(new_ptr, 0, new_size);
-    memmove(new_ptr, ptr, old_size);
+    if (ptr == NULL)
+        return mem_pool_alloc(pool, new_size);
+    if (new_size <= old_size)
+        return ptr;
+
+    // the latest allocation of the current block grows in place
+    size_t aligned_old = MEM_POOL_ALIGN(old_size);
+    size_t aligned_new = MEM_POOL_ALIGN(new_size);
+    if (aligned_old < pool->small_buffer_capacity &&
+        aligned_new < pool->small_buffer_capacity &&
+        is_last_allocation(pool, ptr, aligned_old)) {
+        small_block *sbp = pool->cur_usable_small_block;
+        if ((size_t)(sbp->buffer_end - (u1*)ptr) >= aligned_new) {
+            sbp->cur_usable_buffer = (u1*)ptr + aligned_new;
+            pool->alloc_bytes += aligned_new - aligned_old;
+            memset((u1*)ptr + old_size, 0, new_size - old_size);
+            return ptr;
+        }
+    }
+
+    u1 *new_ptr = mem_pool_alloc_raw(pool, new_size);
+    memcpy(new_ptr, ptr, old_size);
+    memset(new_ptr + old_size, 0, new_size - old_size);
+    mem_pool_release(pool, ptr, old_size);
     return new_ptr;
 }
 
-void mem_pool_free_big_block(mem_pool *pool, u1 *buffer_ptr)
+// <editor-fold defaultstate="collapsed" desc="file mapping">
+
+static void* mem_pool_read_file(mem_pool *pool, int fd, size_t size)
 {
-    big_block *bbp = pool->big_block_start;
-    while (bbp) {
-        if (bbp->big_buffer == buffer_ptr) {
-            free(bbp->big_buffer);
-            bbp->big_buffer = NULL;
-            return;
+    u1 *buffer = mem_pool_alloc_raw(pool, size + 1);
+    size_t off = 0;
+    while (off < size) {
+        ssize_t n = read(fd, buffer + off, size - off);
+        if (n <= 0)
+            break;
+        off += n;
+    }
+    buffer[off] = '\0';
+    return buffer;
+}
+
+/**
+ * map the whole file read-only and hand the pages to the parser as is,
+ * the mapping lives as long as the pool (until mem_pool_clear/free).
+ * empty files, pipes and platforms without mmap fall back to read(2)
+ * into the pool
+ **/
+void* mem_pool_map_file(mem_pool *pool, const char *path, size_t *size)
+{
+#ifdef _WIN32
+    int fd = open(path, O_RDONLY | O_BINARY);
+#else
+    int fd = open(path, O_RDONLY);
+#endif
+    if (fd < 0) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    size_t file_size = (size_t)st.st_size;
+    *size = file_size;
+
+#ifndef _WIN32
+    if (S_ISREG(st.st_mode) && file_size > 0) {
+        void *addr = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            madvise(addr, file_size, MADV_SEQUENTIAL);
+            madvise(addr, file_size, MADV_WILLNEED);
+            close(fd);
+
+            mem_mapped_file *mf = mem_pool_bump(pool, sizeof(mem_mapped_file));
+            mf->addr = addr;
+            mf->size = file_size;
+            mf->next = pool->mapped_start;
+            pool->mapped_start = mf;
+            return addr;
         }
-        bbp = bbp->next_block;
     }
+#endif
+
+    void *buffer = mem_pool_read_file(pool, fd, file_size);
+    close(fd);
+    return buffer;
 }
+
+// </editor-fold>
@@ -8,23 +8,79 @@
 #include "common/types.h"
 #include "mem_common.h"
 
+/**
+ * every allocation is rounded up to this, it also gives the sloppy
+ * "buf[len] = '\0'" writes some room before the next allocation
+ **/
+#define MEM_POOL_ALIGNMENT          8
+
+#define MEM_POOL_SMALL_CAPACITY     (16 * 1024)
+
+/**
+ * small blocks grow geometrically from the first block's capacity
+ * up to this, so a long method needs only a few mallocs
+ **/
+#define MEM_POOL_MAX_BLOCK_CAPACITY (1024 * 1024)
+
+/**
+ * mem_pool_clear keeps at most this much of small blocks for the next
+ * round, blocks grown by an outlier (a huge class) are given back
+ **/
+#define MEM_POOL_RETAIN_CAPACITY    (8 * 1024 * 1024)
+
+/**
+ * regions abandoned by mem_pool_realloc are kept in power of two
+ * size classes, class i holds regions of at least 16 << i bytes
+ **/
+#define MEM_POOL_MIN_CLASS_SHIFT    4
+#define MEM_POOL_SIZE_CLASSES       10
+
 typedef struct small_block {
     u1                  *cur_usable_buffer;
     u1                  *buffer_end;
     struct small_block  *next_block;
-    int                 no_enough_times;
+    size_t              capacity;
 } small_block;
 
 typedef struct big_block {
     u1                  *big_buffer;
     struct big_block    *next_block;
+    size_t              size;
 } big_block;
 
+/**
+ * free regions are tracked out of band, so a stray write
+ * into a dead region can not corrupt the free lists
+ **/
+typedef struct mem_free_list {
+    void                **regions;
+    size_t              size;
+    size_t              capacity;
+} mem_free_list;
+
+/**
+ * a read-only file mapping owned by the pool,
+ * it is unmapped together with the big blocks
+ **/
+typedef struct mem_mapped_file {
+    void                    *addr;
+    size_t                  size;
+    struct mem_mapped_file  *next;
+} mem_mapped_file;
+
 typedef struct mem_pool {
     size_t          total_size;
     size_t          small_buffer_capacity;
+    size_t          next_block_capacity;
+    size_t          free_regions;
+    size_t          alloc_bytes;    // bytes handed out so far, for --profile
     small_block     *cur_usable_small_block;
     big_block       *big_block_start;
+    mem_mapped_file *mapped_start;
+    // pools freed together with this one, see mem_pool_adopt
+    struct mem_pool *adopted_start;
+    struct mem_pool *next_adopted;
+    mem_free_list   free_lists[MEM_POOL_SIZE_CLASSES];
     small_block     small_block_start[0];
 
 } mem_pool;
@@ -36,30 +92,50 @@ void mem_pool_free(mem_pool* pool);
 
 void mem_pool_clear(mem_pool *pool);
 
+void mem_pool_trim(mem_pool *pool, size_t retain_capacity);
+
 u1* mem_pool_new_small_block(mem_pool* pool, size_t size);
 
 u1* mem_pool_new_big_block(mem_pool* pool, size_t size);
 
 void* mem_pool_alloc(mem_pool* pool, size_t size);
 
+void* mem_pool_alloc_raw(mem_pool* pool, size_t size);
+
 void mem_pool_free_big_block(mem_pool* pool, u1* buffer_ptr);
 
+void mem_pool_release(mem_pool *pool, void *ptr, size_t size);
+
 void* mem_pool_realloc(mem_pool *pool,
                        void *ptr,
                        size_t old_size,
                        size_t new_size);
 
+void* mem_pool_map_file(mem_pool *pool, const char *path, size_t *size);
+
+/**
+ * child is freed when pool is freed or cleared, only the thread
+ * owning pool may adopt into it
+ **/
+void mem_pool_adopt(mem_pool *pool, mem_pool *child);
+
 
 extern mem_pool *global_pool;
 
 void mem_init_pool();
 
+mem_pool* x_current_pool();
+
 mem_pool* mem_create_pool();
 
 void* x_alloc(size_t size);
 
 void* x_alloc_in(mem_pool *pool, size_t size);
 
+void* x_alloc_raw(size_t size);
+
+void* x_alloc_raw_in(mem_pool *pool, size_t size);
+
 void* x_realloc(void *ptr, size_t old_size, size_t new_size);
 
 void* x_realloc_in(mem_pool *pool,
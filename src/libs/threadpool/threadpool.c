@@ -1,5 +1,6 @@
 #include <stdlib.h>
 #include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <string.h>
@@ -7,7 +8,7 @@
 #include "threadpool.h"
 #include "debug.h"
 
-static void *threadpool_thread(void *threadpool);
+static void *threadpool_thread(void *worker);
 
 int threadpool_free(threadpool_t *pool);
 
@@ -19,6 +20,238 @@ thread_local_data* get_thread_local_data() {
     return pthread_getspecific(tls_key);
 }
 
+// <editor-fold defaultstate="collapsed" desc="work stealing deque">
+
+/**
+ * Chase-Lev deque with the C11 memory orders from
+ * "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Le, Pop, Cohen, Zappa Nardelli, PPoPP'13).
+ * task slots are read with relaxed atomics by thieves, a torn read
+ * only happens when the CAS on top fails and the value is dropped.
+ **/
+
+static threadpool_deque_array* deque_array_create(long capacity)
+{
+    size_t size = sizeof(threadpool_deque_array) +
+                  sizeof(threadpool_task_t) * capacity;
+    threadpool_deque_array *a = malloc(size);
+    if (a == NULL) {
+        perror("Failed to allocate threadpool deque");
+        exit(EXIT_FAILURE);
+    }
+    a->capacity = capacity;
+    a->prev = NULL;
+    return a;
+}
+
+static void deque_init(threadpool_deque_t *d)
+{
+    d->top = 0;
+    d->bottom = 0;
+    d->array = deque_array_create(THREADPOOL_DEQUE_CAPACITY);
+}
+
+static void deque_release(threadpool_deque_t *d)
+{
+    threadpool_deque_array *a = d->array;
+    while (a != NULL) {
+        threadpool_deque_array *prev = a->prev;
+        free(a);
+        a = prev;
+    }
+    d->array = NULL;
+}
+
+static inline void deque_slot_store(threadpool_deque_array *a,
+                                    long i,
+                                    threadpool_task_t *task)
+{
+    threadpool_task_t *slot = &a->tasks[i & (a->capacity - 1)];
+    __atomic_store_n(&slot->function, task->function, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->argument, task->argument, __ATOMIC_RELAXED);
+}
+
+static inline void deque_slot_load(threadpool_deque_array *a,
+                                   long i,
+                                   threadpool_task_t *task)
+{
+    threadpool_task_t *slot = &a->tasks[i & (a->capacity - 1)];
+    task->function = __atomic_load_n(&slot->function, __ATOMIC_RELAXED);
+    task->argument = __atomic_load_n(&slot->argument, __ATOMIC_RELAXED);
+}
+
+static threadpool_deque_array* deque_grow(threadpool_deque_t *d,
+                                          threadpool_deque_array *a,
+                                          long top,
+                                          long bottom)
+{
+    threadpool_deque_array *n = deque_array_create(a->capacity * 2);
+    for (long i = top; i < bottom; ++i) {
+        threadpool_task_t task;
+        deque_slot_load(a, i, &task);
+        deque_slot_store(n, i, &task);
+    }
+    n->prev = a;
+    __atomic_store_n(&d->array, n, __ATOMIC_RELEASE);
+    return n;
+}
+
+static void deque_push(threadpool_deque_t *d, threadpool_task_t *task)
+{
+    long b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    long t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    threadpool_deque_array *a = __atomic_load_n(&d->array, __ATOMIC_RELAXED);
+    if (b - t > a->capacity - 1)
+        a = deque_grow(d, a, t, b);
+    deque_slot_store(a, b, task);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+}
+
+static bool deque_take(threadpool_deque_t *d, threadpool_task_t *task)
+{
+    long b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) - 1;
+    threadpool_deque_array *a = __atomic_load_n(&d->array, __ATOMIC_RELAXED);
+    __atomic_store_n(&d->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long t = __atomic_load_n(&d->top, __ATOMIC_RELAXED);
+
+    if (t > b) {
+        // empty
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    deque_slot_load(a, b, task);
+    if (t == b) {
+        // the last one, race against thieves
+        bool won = __atomic_compare_exchange_n(&d->top, &t, t + 1, false,
+                                               __ATOMIC_SEQ_CST,
+                                               __ATOMIC_RELAXED);
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+        return won;
+    }
+    return true;
+}
+
+/**
+ * take the bottom task only when it runs function, the bottom slot is
+ * only written by the owner so it can be peeked before taking it
+ **/
+static bool deque_take_if(threadpool_deque_t *d,
+                          threadpool_task_t *task,
+                          void (*function)(void *))
+{
+    long b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    long t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    if (t >= b)
+        return false;
+
+    threadpool_deque_array *a = __atomic_load_n(&d->array, __ATOMIC_RELAXED);
+    threadpool_task_t peek;
+    deque_slot_load(a, b - 1, &peek);
+    if (peek.function != function)
+        return false;
+    return deque_take(d, task);
+}
+
+/**
+ * function: only steal a task running it, NULL steals any task
+ **/
+static bool deque_steal(threadpool_deque_t *d,
+                        threadpool_task_t *task,
+                        void (*function)(void *))
+{
+    long t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long b = __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+    if (t >= b)
+        return false;
+
+    threadpool_deque_array *a = __atomic_load_n(&d->array, __ATOMIC_ACQUIRE);
+    deque_slot_load(a, t, task);
+    if (function != NULL && task->function != function)
+        return false;
+    return __atomic_compare_exchange_n(&d->top, &t, t + 1, false,
+                                       __ATOMIC_SEQ_CST,
+                                       __ATOMIC_RELAXED);
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="submission queue">
+
+/**
+ * bounded MPMC queue (Dmitry Vyukov), used by threads which are not
+ * workers of the pool (the main thread), workers push to their deque.
+ **/
+
+static void queue_init(threadpool_t *pool)
+{
+    for (int i = 0; i < pool->queue_size; ++i)
+        pool->queue[i].seq = i;
+    pool->enqueue_pos = 0;
+    pool->dequeue_pos = 0;
+}
+
+static bool queue_push(threadpool_t *pool, threadpool_task_t *task)
+{
+    size_t mask = pool->queue_size - 1;
+    size_t pos = __atomic_load_n(&pool->enqueue_pos, __ATOMIC_RELAXED);
+    threadpool_cell_t *cell;
+    for (;;) {
+        cell = &pool->queue[pos & mask];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&pool->enqueue_pos, &pos, pos + 1,
+                                            true,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+                break;
+        }
+        else if (dif < 0) {
+            return false;
+        }
+        else {
+            pos = __atomic_load_n(&pool->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+    cell->task = *task;
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static bool queue_pop(threadpool_t *pool, threadpool_task_t *task)
+{
+    size_t mask = pool->queue_size - 1;
+    size_t pos = __atomic_load_n(&pool->dequeue_pos, __ATOMIC_RELAXED);
+    threadpool_cell_t *cell;
+    for (;;) {
+        cell = &pool->queue[pos & mask];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&pool->dequeue_pos, &pos, pos + 1,
+                                            true,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+                break;
+        }
+        else if (dif < 0) {
+            return false;
+        }
+        else {
+            pos = __atomic_load_n(&pool->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+    *task = cell->task;
+    __atomic_store_n(&cell->seq, pos + mask + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// </editor-fold>
+
 threadpool_t* threadpool_create_in(mem_pool *mem_pool, int cnt, int flags)
 {
     threadpool_t *pool;
@@ -33,10 +266,12 @@ threadpool_t* threadpool_create_in(mem_pool *mem_pool, int cnt, int flags)
     pool->thread_count = cnt;
     pool->mem_pool = mem_pool;
     pool->queue_size = MAX_QUEUE;
-    pool->head = pool->tail = pool->count = 0;
+    pool->count = pool->running = pool->sleepers = 0;
     pool->shutdown = pool->started = 0;
     pool->threads = x_alloc_in(mem_pool, sizeof(pthread_t) * cnt);
-    pool->queue = x_alloc_in(mem_pool, sizeof(threadpool_task_t) * pool->queue_size);
+    pool->workers = x_alloc_in(mem_pool, sizeof(threadpool_worker_t) * cnt);
+    pool->queue = x_alloc_in(mem_pool,
+                             sizeof(threadpool_cell_t) * pool->queue_size);
     pool->init_count = 0;
 
     pool->lock = malloc(sizeof(pthread_mutex_t));
@@ -47,17 +282,26 @@ threadpool_t* threadpool_create_in(mem_pool *mem_pool, int cnt, int flags)
        (pthread_cond_init(pool->notify, NULL) != 0) ||
        (pthread_cond_init(pool->init_cond, NULL) != 0) ||
        (pool->threads == NULL) ||
+       (pool->workers == NULL) ||
        (pool->queue == NULL)) {
         goto err;
     }
 
+    queue_init(pool);
+    for (i = 0; i < cnt; i++) {
+        threadpool_worker_t *worker = &pool->workers[i];
+        worker->index = i;
+        worker->seed = (unsigned int)(i + 1) * 2654435761u;
+        worker->threadpool = pool;
+        deque_init(&worker->deque);
+    }
+
     for(i = 0; i < cnt; i++) {
         int _result = pthread_create(&pool->threads[i],
                                      NULL,
                                      threadpool_thread,
-                                     pool);
+                                     &pool->workers[i]);
         if(_result != 0) {
-            pthread_mutex_unlock(pool->lock);
             threadpool_destroy(pool, 0);
             return NULL;
         }
@@ -79,73 +323,56 @@ threadpool_t* threadpool_create_in(mem_pool *mem_pool, int cnt, int flags)
     return NULL;
 }
 
+static void threadpool_wakeup(threadpool_t *pool)
+{
+    if (__atomic_load_n(&pool->sleepers, __ATOMIC_SEQ_CST) == 0)
+        return;
+    pthread_mutex_lock(pool->lock);
+    pthread_cond_signal(pool->notify);
+    pthread_mutex_unlock(pool->lock);
+}
+
 int threadpool_add(threadpool_t *pool,
                    void (*function)(void *),
                    void *argument,
                    int flags)
 {
-    int err = 0;
-
     (void) flags;
 
     if (pool == NULL || function == NULL) {
         return threadpool_invalid;
     }
 
-    if (pthread_mutex_lock(pool->lock) != 0) {
-        return threadpool_lock_failure;
-    }
-
-    do {
-        if (pool->tail >= pool->queue_size) {
-            if (pool->head > 0) {
-
-                memmove(pool->queue, &pool->queue[pool->head],
-                        sizeof(threadpool_task_t) * pool->count);
-                pool->tail = pool->count;
-                pool->head = 0;
-            }
-            if (pool->tail >= pool->queue_size) {
-                int new_size = pool->queue_size * 2;
-                size_t old_mem = sizeof(threadpool_task_t) * pool->queue_size;
-
-                size_t new_mem = sizeof(threadpool_task_t) * new_size;
-
-                threadpool_task_t *new_queue =
-                        x_realloc(pool->queue, old_mem, new_mem);
-
-                if (!new_queue) {
-                    err = threadpool_lock_failure;
-                    break;
-                }
-                pool->queue = new_queue;
-                pool->queue_size = new_size;
-            }
-        }
+    thread_local_data *tls = get_thread_local_data();
+    bool from_worker = tls != NULL && tls->worker != NULL &&
+                       tls->worker->threadpool == pool;
 
-        if (pool->shutdown) {
-            err = threadpool_shutdown;
-            break;
-        }
+    // running tasks may still add sub tasks while the pool drains
+    int shutdown = __atomic_load_n(&pool->shutdown, __ATOMIC_ACQUIRE);
+    if (shutdown == immediate_shutdown || (shutdown && !from_worker)) {
+        return threadpool_shutdown;
+    }
 
-        pool->queue[pool->tail].function = function;
-        pool->queue[pool->tail].argument = argument;
+    threadpool_task_t task;
+    task.function = function;
+    task.argument = argument;
 
-        pool->tail++;
-        pool->count++;
+    __atomic_add_fetch(&pool->count, 1, __ATOMIC_SEQ_CST);
 
-        if (pthread_cond_signal(pool->notify) != 0) {
-            err = threadpool_lock_failure;
-            break;
+    if (from_worker) {
+        // sub task of a running task, keep it local, idle workers steal it
+        deque_push(&tls->worker->deque, &task);
+    }
+    else {
+        while (!queue_push(pool, &task)) {
+            // back pressure, the workers drain the queue meanwhile
+            threadpool_wakeup(pool);
+            sched_yield();
         }
-
-    } while (0);
-
-    if (pthread_mutex_unlock(pool->lock) != 0) {
-        err = threadpool_lock_failure;
     }
 
-    return err;
+    threadpool_wakeup(pool);
+    return 0;
 }
 
 int threadpool_destroy(threadpool_t *pool, int flags)
@@ -162,14 +389,18 @@ int threadpool_destroy(threadpool_t *pool, int flags)
 
     do {
         if(pool->shutdown) {
+            pthread_mutex_unlock(pool->lock);
             err = threadpool_shutdown;
             break;
         }
 
-        pool->shutdown = (flags & threadpool_graceful) ?
-                         graceful_shutdown : immediate_shutdown;
+        __atomic_store_n(&pool->shutdown,
+                         (flags & threadpool_graceful) ?
+                         graceful_shutdown : immediate_shutdown,
+                         __ATOMIC_SEQ_CST);
 
         if (pthread_cond_broadcast(pool->notify) != 0) {
+            pthread_mutex_unlock(pool->lock);
             err = threadpool_lock_failure;
             break;
         }
@@ -180,11 +411,12 @@ int threadpool_destroy(threadpool_t *pool, int flags)
         }
 
 
-        for(i = 0; i < pool->thread_count; i++) {
+        for(i = 0; i < pool->started; i++) {
             if(pthread_join(pool->threads[i], NULL) != 0) {
                 err = threadpool_thread_failure;
             }
         }
+        pool->started = 0;
     } while(0);
 
     if(!err) {
@@ -199,7 +431,9 @@ int threadpool_free(threadpool_t *pool)
         return -1;
     }
 
-//    pthread_mutex_lock(&(pool->lock));
+    for (int i = 0; i < pool->thread_count; ++i)
+        deque_release(&pool->workers[i].deque);
+
     pthread_mutex_destroy(pool->lock);
     pthread_cond_destroy(pool->notify);
     pthread_cond_destroy(pool->init_cond);
@@ -210,23 +444,132 @@ int threadpool_free(threadpool_t *pool)
     return 0;
 }
 
-void thread_local_data_init(threadpool_t *pool, pthread_t tid) {
+void thread_local_data_init(threadpool_worker_t *worker) {
     pthread_once(&tls_init_once, create_tls_key);
-    mem_pool *mpool = pool->mem_pool;
-    thread_local_data *tls = x_alloc_in(mpool, sizeof(thread_local_data));
-    if (!tls) {
-        perror("Failed to allocate thread local storage");
-        exit(EXIT_FAILURE);
-    }
+    thread_local_data *tls = &worker->tls;
+    tls->thread_id = worker->index;
+    tls->pool = NULL;
+    tls->arena = mem_create_pool();
+    tls->worker = worker;
     pthread_setspecific(tls_key, tls);
 }
 
-static void *threadpool_thread(void *threadpool)
+static inline unsigned int worker_next_random(threadpool_worker_t *worker)
+{
+    // xorshift32
+    unsigned int x = worker->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    worker->seed = x;
+    return x;
+}
+
+static bool worker_steal(threadpool_worker_t *worker,
+                         threadpool_task_t *task,
+                         void (*function)(void *))
+{
+    threadpool_t *pool = worker->threadpool;
+    int n = pool->thread_count;
+    int start = (int)(worker_next_random(worker) % n);
+    for (int i = 0; i < n; ++i) {
+        threadpool_worker_t *victim = &pool->workers[(start + i) % n];
+        if (victim == worker)
+            continue;
+        if (deque_steal(&victim->deque, task, function))
+            return true;
+    }
+    return false;
+}
+
+static bool worker_find_task(threadpool_worker_t *worker,
+                             threadpool_task_t *task)
 {
-    threadpool_t *pool = (threadpool_t *)threadpool;
+    threadpool_t *pool = worker->threadpool;
+    if (deque_take(&worker->deque, task) ||
+        queue_pop(pool, task) ||
+        worker_steal(worker, task, NULL)) {
+        // running first, count and running are never both 0 in between
+        __atomic_add_fetch(&pool->running, 1, __ATOMIC_SEQ_CST);
+        __atomic_sub_fetch(&pool->count, 1, __ATOMIC_SEQ_CST);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * the last running task of a graceful shutdown wakes the sleepers up,
+ * nothing can add a task anymore so they exit
+ **/
+static void worker_task_done(threadpool_t *pool)
+{
+    if (__atomic_sub_fetch(&pool->running, 1, __ATOMIC_SEQ_CST) != 0 ||
+        !__atomic_load_n(&pool->shutdown, __ATOMIC_SEQ_CST))
+        return;
+    pthread_mutex_lock(pool->lock);
+    pthread_cond_broadcast(pool->notify);
+    pthread_mutex_unlock(pool->lock);
+}
+
+/**
+ * a running task may still add sub tasks, the pool is only drained
+ * when nothing is queued and nothing is running
+ **/
+static bool worker_no_work_left(threadpool_t *pool)
+{
+    return __atomic_load_n(&pool->count, __ATOMIC_SEQ_CST) == 0 &&
+           __atomic_load_n(&pool->running, __ATOMIC_SEQ_CST) == 0;
+}
+
+static bool worker_should_exit(threadpool_t *pool)
+{
+    int shutdown = __atomic_load_n(&pool->shutdown, __ATOMIC_SEQ_CST);
+    return shutdown == immediate_shutdown ||
+           (shutdown == graceful_shutdown && worker_no_work_left(pool));
+}
+
+static void worker_sleep(threadpool_worker_t *worker)
+{
+    threadpool_t *pool = worker->threadpool;
+    pthread_mutex_lock(pool->lock);
+    __atomic_add_fetch(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&pool->count, __ATOMIC_SEQ_CST) == 0 &&
+           !worker_should_exit(pool)) {
+        pthread_cond_wait(pool->notify, pool->lock);
+    }
+    __atomic_sub_fetch(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(pool->lock);
+}
+
+void threadpool_join(threadpool_t *pool,
+                     void (*function)(void *),
+                     int *pending)
+{
+    thread_local_data *tls = get_thread_local_data();
+    threadpool_worker_t *worker = tls != NULL ? tls->worker : NULL;
     threadpool_task_t task;
 
-    thread_local_data_init(threadpool, pthread_self());
+    while (__atomic_load_n(pending, __ATOMIC_ACQUIRE) > 0) {
+        if (worker != NULL &&
+            (deque_take_if(&worker->deque, &task, function) ||
+             worker_steal(worker, &task, function))) {
+            __atomic_sub_fetch(&pool->count, 1, __ATOMIC_SEQ_CST);
+            (*(task.function))(task.argument);
+            continue;
+        }
+        // the rest is running on other workers
+        sched_yield();
+    }
+}
+
+static void *threadpool_thread(void *arg)
+{
+    threadpool_worker_t *worker = (threadpool_worker_t *)arg;
+    threadpool_t *pool = worker->threadpool;
+    threadpool_task_t task;
+    int idle = 0;
+
+    thread_local_data_init(worker);
 
     pthread_mutex_lock(pool->lock);
     pool->init_count++;
@@ -234,30 +577,33 @@ static void *threadpool_thread(void *threadpool)
     pthread_mutex_unlock(pool->lock);
 
     for(;;) {
-        pthread_mutex_lock(pool->lock);
+        if (__atomic_load_n(&pool->shutdown, __ATOMIC_ACQUIRE) ==
+            immediate_shutdown)
+            break;
 
-        while((pool->count == 0) && (!pool->shutdown)) {
-            pthread_cond_wait(pool->notify, pool->lock);
+        if (worker_find_task(worker, &task)) {
+            idle = 0;
+            (*(task.function))(task.argument);
+            worker_task_done(pool);
+            continue;
         }
 
-        if((pool->shutdown == immediate_shutdown) ||
-           ((pool->shutdown == graceful_shutdown) &&
-            (pool->count == 0))) {
+        if (worker_should_exit(pool))
             break;
-        }
 
-        task.function = pool->queue[pool->head].function;
-        task.argument = pool->queue[pool->head].argument;
-
-        pool->head++;
-        pool->count--;
-
-        pthread_mutex_unlock(pool->lock);
+        if (__atomic_load_n(&pool->count, __ATOMIC_SEQ_CST) > 0 ||
+            ++idle < THREADPOOL_SPIN_ROUNDS) {
+            // a task is being published, or give the others a chance
+            sched_yield();
+            continue;
+        }
 
-        (*(task.function))(task.argument);
+        idle = 0;
+        worker_sleep(worker);
     }
-    pool->started--;
-    pthread_mutex_unlock(pool->lock);
+    worker->tls.pool = NULL;
+    mem_pool_free(worker->tls.arena);
+    worker->tls.arena = NULL;
     pthread_exit(NULL);
     return(NULL);
 }
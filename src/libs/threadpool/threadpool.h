@@ -6,6 +6,17 @@
 #define MAX_THREADS 64
 #define MAX_QUEUE 65536
 
+/**
+ * initial capacity of every worker's deque, it grows by doubling
+ * when a worker pushes more sub tasks than this
+ **/
+#define THREADPOOL_DEQUE_CAPACITY 256
+
+/**
+ * an idle worker tries to steal this many rounds before it sleeps
+ **/
+#define THREADPOOL_SPIN_ROUNDS 64
+
 typedef struct threadpool_t threadpool_t;
 
 
@@ -27,18 +38,79 @@ typedef struct {
     void *argument;
 } threadpool_task_t;
 
+/**
+ * cell of the bounded MPMC submission queue (Vyukov),
+ * seq tells producers/consumers whose turn the cell is
+ **/
+typedef struct {
+    size_t              seq;
+    threadpool_task_t   task;
+} threadpool_cell_t;
+
+/**
+ * ring buffer of a Chase-Lev deque, a grown deque keeps the
+ * retired arrays on the prev chain because thieves may still
+ * be reading them, they are released in threadpool_free
+ **/
+typedef struct threadpool_deque_array {
+    long                            capacity;
+    struct threadpool_deque_array   *prev;
+    threadpool_task_t               tasks[];
+} threadpool_deque_array;
+
+/**
+ * Chase-Lev work stealing deque, only the owner worker pushes and
+ * takes at the bottom, other workers steal at the top
+ **/
+typedef struct {
+    long                    top;
+    long                    bottom;
+    threadpool_deque_array  *array;
+} threadpool_deque_t;
+
+typedef struct threadpool_worker_t threadpool_worker_t;
+
+/**
+ * pool:  where x_alloc allocates on this thread
+ * arena: the worker's long-lived pool, a task points pool at it and
+ *        rewinds it with mem_pool_clear when done, instead of a
+ *        mem_create_pool/mem_pool_free pair for every class
+ **/
+typedef struct {
+    int thread_id;
+    mem_pool *pool;
+    mem_pool *arena;
+    threadpool_worker_t *worker;
+} thread_local_data;
+
+struct threadpool_worker_t {
+    int                 index;
+    unsigned int        seed;
+    threadpool_t        *threadpool;
+    threadpool_deque_t  deque;
+    thread_local_data   tls;
+};
+
 struct threadpool_t {
     int init_count;
     pthread_mutex_t *lock;
     pthread_cond_t *notify;
     pthread_cond_t *init_cond;
     pthread_t *threads;
-    threadpool_task_t *queue;
-    int thread_count;
+    threadpool_worker_t *workers;
+
+    /* lock-free submission queue for non-worker threads */
+    threadpool_cell_t *queue;
     int queue_size;
-    int head;
-    int tail;
+    size_t enqueue_pos;
+    size_t dequeue_pos;
+
+    int thread_count;
+    /* tasks submitted but not taken by any worker yet */
     int count;
+    /* tasks taken by a worker and not finished, they may add more */
+    int running;
+    int sleepers;
     int shutdown;
     int started;
     mem_pool *mem_pool;
@@ -56,11 +128,6 @@ typedef enum {
     threadpool_graceful       = 1
 } threadpool_destroy_flags_t;
 
-typedef struct {
-    int thread_id;
-    mem_pool *pool;
-} thread_local_data;
-
 static pthread_key_t tls_key;
 static pthread_once_t tls_init_once = PTHREAD_ONCE_INIT;
 
@@ -75,7 +142,17 @@ int threadpool_add(threadpool_t *pool,
 
 int threadpool_destroy(threadpool_t *pool, int flags);
 
-void thread_local_data_init(threadpool_t *pool, pthread_t tid);
+/**
+ * wait inside a running task until *pending drops to 0, meanwhile the
+ * worker runs the sub tasks of function from its own deque or steals
+ * them from others, never an unrelated task which could hold up the
+ * join for a whole class
+ **/
+void threadpool_join(threadpool_t *pool,
+                     void (*function)(void *),
+                     int *pending);
+
+void thread_local_data_init(threadpool_worker_t *worker);
 
 thread_local_data* get_thread_local_data();
 
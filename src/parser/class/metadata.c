@@ -27,17 +27,10 @@ jsource_file* init_java_source_file(jclass_file *jc)
 
 void init_java_class_content(jclass_file *jc, const char *path)
 {
-    FILE *file = fopen(path, "r");
-    fseek(file, 0, SEEK_END);
-    size_t file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
     jd_bin *bin = make_obj(jd_bin);
-    bin->buffer_size = file_size;
-    bin->buffer = x_alloc(file_size);
+    bin->buffer = mem_pool_map_file(x_current_pool(), path, &bin->buffer_size);
     bin->cur_off = 0;
-    fread(bin->buffer, 1, file_size, file);
     jc->bin = bin;
-    fclose(file);
 }
 
 jclass_file* init_java_class_from_file(const char* path)
@@ -134,7 +127,7 @@ static void setup_string_of_const_pool(jclass_file *jc)
             }
             case CONST_CLASS_TAG: {
                 jcp_info *utf8 = pool_item(jc, info->class->name_index);
-                item->readable = str_create("%s", utf8->readable);
+                item->readable = str_intern(utf8->readable);
                 break;
             }
             case CONST_INTEGER_TAG: {
@@ -285,9 +278,8 @@ void parse_constant_pool_section(jclass_file *jc)
                 } else {
                     utf8->bytes = x_alloc(_utf8_length);
                     jclass_read(jc, utf8->bytes, _utf8_length);
-                    item->readable = x_alloc(_utf8_length+1);
-                    memcpy(item->readable, utf8->bytes, _utf8_length);
-                    item->readable[_utf8_length] = '\0';
+                    item->readable = str_intern_n((char*)utf8->bytes,
+                                                  _utf8_length);
                 }
                 item->name = str_utf8;
                 break;
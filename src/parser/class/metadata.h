@@ -33,7 +33,7 @@ jattr* parse_attributes_section(jclass_file*, uint16_t);
 
 void parse_methods_section(jclass_file*);
 
-void print_code_section(jclass_file*, jattr_code*);
+void print_code_section(jclass_file*, jattr_code*, FILE*);
 
 void print_java_class_file_info(jclass_file*);
 
@@ -182,8 +182,39 @@ typedef enum dex_instruction_format {
     kFmt3rmi,
     kFmt45cc,
     kFmt4rcc,
+    kFmtCount,
 } dex_instruction_format;
 
+// opcode classes, one bit each so the dex_ins_is_* predicates are a test
+enum {
+    DEX_OPF_GOTO            = 1 << 0,
+    DEX_OPF_IF              = 1 << 1,
+    DEX_OPF_SWITCH          = 1 << 2,
+    DEX_OPF_RETURN          = 1 << 3,
+    DEX_OPF_COMPARE         = 1 << 4,
+    DEX_OPF_COPY_BLOCK      = 1 << 5,
+    DEX_OPF_MOVE            = 1 << 6,
+    DEX_OPF_MOVE_RESULT     = 1 << 7,
+    DEX_OPF_INVOKE_DYNAMIC  = 1 << 8,
+
+    DEX_OPF_BRANCH          = DEX_OPF_GOTO | DEX_OPF_IF | DEX_OPF_SWITCH,
+    DEX_OPF_BLOCK_END       = DEX_OPF_BRANCH | DEX_OPF_RETURN |
+                              DEX_OPF_COPY_BLOCK,
+};
+
+#define DEX_OPCODE_COUNT 256
+
+/**
+ * length is in code units and 0 for unused opcodes, the nop payloads
+ * (switch and array data) carry their own length
+ **/
+typedef struct {
+    const char  *name;
+    u1          length;
+    u1          format;
+    u2          flags;
+} dex_opcode_info;
+
 enum {
     DBG_END_SEQUENCE         = 0x00,
     DBG_ADVANCE_PC           = 0x01,
@@ -518,6 +549,9 @@ struct DexEncodedArray {
     u1  *array;
 };
 
+/**
+ * filled on first use by dex_string_data, data is NULL until then
+ **/
 typedef struct {
     uint32_t utf16_size;
     char *data;
@@ -557,8 +591,22 @@ typedef struct jd_meta_dex {
     hashmap *synthetic_classes_map;
     hashmap *lambda_method_map;
     mem_pool *pool;
+    // class names derived while decompiling, shared by the workers
+    jd_intern *intern;
     string source_dir;
+    // guards pool for the rare string that has to be copied
+    pthread_mutex_t strings_lock;
 } jd_meta_dex;
 
+string dex_string_decode(jd_meta_dex *meta, u4 idx);
+
+static inline string dex_string_data(jd_meta_dex *meta, u4 idx)
+{
+    string data = __atomic_load_n(&meta->strings[idx].data, __ATOMIC_ACQUIRE);
+    if (data != NULL)
+        return data;
+    return dex_string_decode(meta, idx);
+}
+
 
 #endif //GARLIC_DEX_H
@@ -17,7 +17,7 @@ static inline bool dex_encoded_method_is_lambda(jd_meta_dex *meta,
                                                 encoded_method *em)
 {
     dex_method_id method_id = meta->method_ids[em->method_id];
-    string name = meta->strings[method_id.name_idx].data;
+    string name = dex_string_data(meta, method_id.name_idx);
     return str_contains(name, "lambda$") &&
             (em->access_flags & ACC_DEX_SYNTHETIC) != 0;
 }
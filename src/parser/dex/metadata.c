@@ -91,11 +91,11 @@ static void parse_dex_map_list(jd_meta_dex *dex)
     dex->maps = dex->bin->buffer + dex->header->map_off;
 }
 
-static int dex_string_byte_size(jd_meta_dex *dex, uint32_t utf16_size)
+static int dex_string_byte_size(const u1 *data, uint32_t utf16_size)
 {
     int real, cnt;
     for (real = 0, cnt = 0; cnt < utf16_size; ++real, ++cnt) {
-        unsigned char c = dex->bin->buffer[real + dex->bin->cur_off];
+        unsigned char c = data[real];
         if (c > 0 && c < 127) {
         }
         else if (c >= 0xE0) {
@@ -105,7 +105,7 @@ static int dex_string_byte_size(jd_meta_dex *dex, uint32_t utf16_size)
             real += 1;
         }
         else if (c == 0xC0) {
-            unsigned char nc = dex->bin->buffer[real+1 + dex->bin->cur_off];
+            unsigned char nc = data[real+1];
             if (nc == 0x80)
                 real += 1;
         }
@@ -113,32 +113,63 @@ static int dex_string_byte_size(jd_meta_dex *dex, uint32_t utf16_size)
     return real;
 }
 
+static u4 dex_uleb128_at(const u1 **ptr)
+{
+    const u1 *p = *ptr;
+    u4 result = 0;
+    int shift = 0;
+    u1 b;
+    do {
+        b = *p++;
+        result |= (u4)(b & 0x7f) << shift;
+        shift += 7;
+    } while ((b & 0x80) && shift < 35);
+    *ptr = p;
+    return result;
+}
+
+/**
+ * string_data_item is already NUL terminated MUTF-8, so a well formed
+ * string (every pure ASCII one) is handed out straight from the dex
+ * buffer, only a malformed one is copied. bin->cur_off is not touched,
+ * class tasks call this concurrently, the first published pointer wins
+ **/
+string dex_string_decode(jd_meta_dex *dex, u4 idx)
+{
+    dex_string_item *item = &dex->strings[idx];
+    const u1 *p = (u1*)dex->bin->buffer + dex->string_ids[idx].string_data_off;
+    u4 size = dex_uleb128_at(&p);
+    int real = dex_string_byte_size(p, size);
+
+    string data;
+    if (p[real] == '\0') {
+        data = (string)p;
+    }
+    else {
+        pthread_mutex_lock(&dex->strings_lock);
+        data = x_alloc_in(dex->pool, real+1);
+        pthread_mutex_unlock(&dex->strings_lock);
+        memcpy(data, p, real);
+        data[real] = '\0';
+    }
+    __atomic_store_n(&item->utf16_size, size, __ATOMIC_RELAXED);
+
+    string expected = NULL;
+    if (!__atomic_compare_exchange_n(&item->data, &expected, data, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        return expected;
+    return data;
+}
+
 static void parse_dex_string_ids(jd_meta_dex *dex)
 {
     dex_header *header = dex->header;
     dex->string_ids = dex->bin->buffer + header->string_ids_off;
 
-
+    // decoded lazily by dex_string_data
     dex->strings = make_obj_arr_in(dex_string_item,
                                    header->string_ids_size,
                                    dex->pool);
-    for (int i = 0; i < header->string_ids_size; ++i) {
-        dex_string_id *string_id = &dex->string_ids[i];
-        dex_string_item *item = &dex->strings[i];
-
-        setup_current_offset(dex, string_id->string_data_off);
-
-        int size = read_unsigned_leb128(dex);
-        item->utf16_size = size;
-
-        int real = dex_string_byte_size(dex, size);
-
-        item->data = x_alloc_in(dex->pool, real+1);
-        memset(item->data, 0, real+1);
-        if (real > 0)
-            jdex_read(dex, item->data, real);
-        item->data[real] = '\0';
-    }
 }
 
 static void parse_dex_type_ids(jd_meta_dex *dex)
@@ -669,7 +700,7 @@ static void parse_dex_code_item(jd_meta_dex *dex, encoded_method *em)
 {
     mem_pool *pool = dex->pool;
     dex_method_id *method_id = &dex->method_ids[em->method_id];
-    string method_name = dex->strings[method_id->name_idx].data;
+    string method_name = dex_string_data(dex, method_id->name_idx);
     setup_current_offset(dex, em->code_off);
     em->code = make_obj_in(dex_code_item, pool);
     dex_code_item *code = em->code;
@@ -870,22 +901,12 @@ static void parse_dex_class_defs(jd_meta_dex *dex)
 
 static jd_meta_dex* init_dex_content(mem_pool *pool, string path)
 {
-    FILE *file = fopen(path, "r");
-    fseek(file, 0, SEEK_END);
-    size_t file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
     jd_meta_dex *dex = make_obj_in(jd_meta_dex, pool);
     dex->pool = pool;
     dex->bin = make_obj_in(jd_bin, pool);
-    dex->bin->buffer_size = file_size;
-    dex->bin->buffer = x_alloc_in(pool, file_size);
+    // header, ids and code items point straight into the mapping
+    dex->bin->buffer = mem_pool_map_file(pool, path, &dex->bin->buffer_size);
     dex->bin->cur_off = 0;
-    fread(dex->bin->buffer, 1, file_size, file);
-//    dalvik->buffer_size = file_size;
-//    dalvik->buffer = x_alloc_in(pool, file_size);
-//    fread(dalvik->buffer, 1, file_size, file);
-//    dalvik->cur_off = 0;
-    fclose(file);
     return dex;
 }
 
@@ -895,6 +916,8 @@ static void init_dex_extract_data(jd_meta_dex *dex)
     dex->lambda_method_map = hashmap_init_in(dex->pool, u4obj_cmp, 0);
     dex->class_type_id_map = hashmap_init_in(dex->pool, u4obj_cmp, 0);
     dex->class_name_map = hashmap_init_in(dex->pool, s2o_cmp, 0);
+    pthread_mutex_init(&dex->strings_lock, NULL);
+    dex->intern = intern_create(dex->pool);
 }
 
 jd_meta_dex* parse_dex_file(string path)
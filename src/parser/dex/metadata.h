@@ -7,14 +7,25 @@ jd_meta_dex* parse_dex_file(string path);
 
 jd_meta_dex* parse_dex_from_buffer(char *buffer, size_t size);
 
-string dex_opcode_name(u1 code);
-
-int dex_opcode_len(u1 code);
-
 int read_unsigned_leb128(jd_meta_dex *dex);
 
 int read_signed_leb128(jd_meta_dex *dex);
 
-dex_instruction_format dex_opcode_fmt(u1 code);
+extern const dex_opcode_info dex_opcodes[DEX_OPCODE_COUNT];
+
+static inline string dex_opcode_name(u1 code)
+{
+    return (string)dex_opcodes[code].name;
+}
+
+static inline int dex_opcode_len(u1 code)
+{
+    return dex_opcodes[code].length;
+}
+
+static inline dex_instruction_format dex_opcode_fmt(u1 code)
+{
+    return dex_opcodes[code].format;
+}
 
 #endif //GARLIC_METADATA_H
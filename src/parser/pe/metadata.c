@@ -10,19 +10,11 @@
 
 static pe_dos_header* init_pe_content(mem_pool *pool, string path)
 {
-    FILE *file = fopen(path, "r");
-    fseek(file, 0, SEEK_END);
-    size_t file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
     pe_file *pe = make_obj_in(pe_file, pool);
     pe->pool = pool;
     pe->bin = make_obj_in(jd_bin, pool);
-    pe->bin->buffer_size = file_size;
-    pe->bin->buffer = x_alloc_in(pool, file_size);
+    pe->bin->buffer = mem_pool_map_file(pool, path, &pe->bin->buffer_size);
     pe->bin->cur_off = 0;
-    fread(pe->bin->buffer, 1, file_size, file);
-    fclose(file);
     return pe;
 }
 